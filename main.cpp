@@ -6,11 +6,18 @@
 #include <memory>
 #include <sstream>
 #include <set>
+#include <fstream>
+#include <thread>
+#include <optional>
 
 #include "topology.hpp"
 #include "calculator.hpp"
+#include "address_space.hpp"
+#include "cidr_import.hpp"
 #include "netparser.hpp"
+#include "prefix.hpp"
 #include "network.hpp"
+#include "subnet_store.hpp"
 #include "logging.hpp"  // Keeping existing logging if needed, though prompt implies new CLI
 #include "documentation.hpp"
 #include "state_manager.hpp"
@@ -21,12 +28,13 @@
 #include "generate_guide.hpp"
 #include "gui_layer.hpp"
 #include "colors.hpp"
+#include "arguments.hpp"
 
 // Global lists to hold our topology
 // Global lists to hold our topology
 std::vector<Device*> devices;
 std::vector<Link*> links;
-std::vector<Network*> subnets;
+SubnetStore subnets;
 
 // Helper to find device by name
 Device* find_device(const std::string& name) {
@@ -310,56 +318,210 @@ int get_hosts_capacity(Network* net) {
     return (int)max_hosts;
 }
 
-// Helper to find network by ID
-Network* get_net_by_id(const std::vector<Network*>& subnets, int id) {
-    for (auto n : subnets) {
-        if (n->id == id) return n;
-    }
-    return nullptr;
+// Arena figures of the subnet store, after a plan was built or loaded
+void log_store_stats() {
+    const StoreStats& stats = subnets.get_stats();
+    LOG_DEBUG("Subnet store: {} subnets, {} created, {} chunks, {} slots", subnets.size(),
+              stats.created, stats.chunks, stats.capacity);
 }
 
-void print_subnet_recursive(const std::vector<Network*>& subnets, Network* current, std::string prefix) {
-    std::string s_net = get_net_str(current);
-    int slash = current->get_slash();
-    int caps = get_hosts_capacity(current);
-    std::string net_display = s_net + "/" + std::to_string(slash);
-    
-    std::string status = current->get_assignment();
-    if (current->is_split) status = "SPLIT";
-    
-    std::string n = current->name.empty() ? "-" : current->name;
-    
-    // Determine connector
-    std::string connector = (current->parent_id == 0) ? "" : "└── ";
-    
-    // DHCP Status Tag
-    std::string dhcp_tag = "";
-    if (!current->is_split && slash < 30) {  // Only for LANs, not WANs or splits
-        if (current->dhcp_enabled) {
-            if (current->dhcp_helper_ip.empty()) {
-                dhcp_tag = std::string(Color::GREEN) + "[DHCP: Server]" + Color::RESET;
-            } else {
-                dhcp_tag = std::string(Color::YELLOW) + "[DHCP: Relay]" + Color::RESET;
+// Prints `root` and everything below it, depth first, children in list order.
+// Walks with an explicit stack, so deep trees do not grow the call stack.
+void print_subnet_tree(const SubnetStore& subnets, Network* root) {
+    std::vector<std::pair<int, int>> pending = {{root->id, 0}};  // (ID, depth)
+    std::string prefix;
+
+    while (!pending.empty()) {
+        auto [id, depth] = pending.back();
+        pending.pop_back();
+        Network* current = subnets.find(id);
+        if (!current) continue;
+
+        std::string s_net = get_net_str(current);
+        int slash = current->get_slash();
+        int caps = get_hosts_capacity(current);
+        std::string net_display = s_net + "/" + std::to_string(slash);
+        
+        std::string status = current->get_assignment().str();
+        if (current->is_split()) status = "SPLIT";
+        
+        std::string n = current->get_name().empty() ? "-" : current->get_name().str();
+        
+        // Children of the root are not indented, every level below adds four spaces
+        const char* connector = (depth == 0) ? "" : "└── ";
+        prefix.assign(depth > 1 ? 4 * (depth - 1) : 0, ' ');
+        
+        // DHCP Status Tag
+        std::string dhcp_tag = "";
+        if (!current->is_split() && slash < 30) {  // Only for LANs, not WANs or splits
+            if (current->get_dhcp_enabled()) {
+                if (current->get_dhcp_helper_ip().empty()) {
+                    dhcp_tag = std::string(Color::GREEN) + "[DHCP: Server]" + Color::RESET;
+                } else {
+                    dhcp_tag = std::string(Color::YELLOW) + "[DHCP: Relay]" + Color::RESET;
+                }
+            } else if (!status.empty() && status != "Free") {
+                dhcp_tag = std::string(Color::CYAN) + "[Static]" + Color::RESET;
             }
-        } else if (!status.empty() && status != "Free") {
-            dhcp_tag = std::string(Color::CYAN) + "[Static]" + Color::RESET;
         }
-    }
 
-    printf("%s%s[%d]  %-18s (%-6d) %-15s [%s] %s\n", 
-           prefix.c_str(), connector.c_str(), current->id, net_display.c_str(), caps, n.c_str(), status.c_str(), dhcp_tag.c_str());
+        printf("%s%s[%d]  %-18s (%-6d) %-15s [%s] %s\n", 
+               prefix.c_str(), connector, current->id, net_display.c_str(), caps, n.c_str(), status.c_str(), dhcp_tag.c_str());
 
-    // Recurse
-    std::string next_prefix = (current->parent_id == 0) ? prefix : prefix + "    ";
-    for (int cid : current->children_ids) {
-        Network* child = get_net_by_id(subnets, cid);
-        if (child) {
-            print_subnet_recursive(subnets, child, next_prefix);
+        // Push the children reversed, so the first one is printed next
+        size_t first = pending.size();
+        for (int cid = subnets.get_first_child(id); cid != 0; cid = subnets.get_next_sibling(cid)) {
+            pending.push_back({cid, depth + 1});
         }
+        std::reverse(pending.begin() + first, pending.end());
     }
 }
 
 void menu_configure_subnets(); 
+void menu_configure_subnets_loop(int next_id_counter);
+
+// Only the spare buddy blocks left over by a split or allocation are free, until they
+// are split, named or assigned; free ones can be handed out again or merged back
+bool subnet_in_use(Network* n) {
+    return !n->is_spare() || n->is_split() || !n->get_name().empty() || n->get_assignment() != SYMBOL_FREE;
+}
+
+// Address space of a split subnet where every child in use is already claimed
+AddressSpace children_space(Network* parent) {
+    AddressSpace space(parent);
+    for (int cid = subnets.get_first_child(parent->id); cid != 0; cid = subnets.get_next_sibling(cid)) {
+        Network* child = subnets.find(cid);
+        if (child && subnet_in_use(child)) {
+            space.claim(Cidr{(uint32_t)child->get_address(), child->get_slash()});
+        }
+    }
+    return space;
+}
+
+// New child of a split subnet; the caller sorts the children once it is done
+Network* add_child_block(Network* parent, Cidr block, int& next_id_counter) {
+    Network* child = subnets.create(block);
+    subnets.set_id(child, next_id_counter++);
+    subnets.add_child(parent->id, child->id);
+    return child;
+}
+
+// Swaps the free children of a split subnet for one spare child per block; the
+// children in use are left alone
+void replace_free_children(Network* parent, const std::vector<Cidr>& spare, int& next_id_counter) {
+    std::vector<Network*> free_children;
+    for (int cid = subnets.get_first_child(parent->id); cid != 0; cid = subnets.get_next_sibling(cid)) {
+        Network* child = subnets.find(cid);
+        if (child && !subnet_in_use(child)) free_children.push_back(child);
+    }
+    subnets.remove(free_children);
+
+    for (const Cidr& block : spare) {
+        add_child_block(parent, block, next_id_counter)->set_spare(true);
+    }
+}
+
+// Allocate/merge actions on a subnet that has already been split
+void manage_split_subnet(Network* parent, int& next_id_counter) {
+    AddressSpace space = children_space(parent);
+
+    std::cout << "Selected: " << get_net_str(parent) << "/" << parent->get_slash() << " (split)\n";
+    std::cout << "Free space: " << space.get_free_addresses() << " addresses";
+    if (space.largest_free_slash() >= 0) {
+        std::cout << ", largest free block /" << space.largest_free_slash();
+    }
+    std::cout << "\n";
+    std::cout << "Action: (A)llocate block, (M)erge free children, (C)ancel: ";
+    char action;
+    std::cin >> action; clear_input();
+
+    if (action == 'A' || action == 'a') {
+        std::cout << "Enter host requirement for the new block: ";
+        int hosts;
+        if (!(std::cin >> hosts)) { clear_input(); return; }
+        clear_input();
+        if (hosts <= 0) {
+            std::cout << Color::RED << Icon::CROSS << " Host count must be at least 1." << Color::RESET << "\n";
+            return;
+        }
+
+        std::optional<Cidr> block = space.allocate(IPV4_NET_BITS - Calculator::host_bits_for(hosts));
+        if (!block) {
+            std::cout << Color::RED << Icon::CROSS << " No free block is big enough for " << hosts << " hosts." << Color::RESET << "\n";
+            return;
+        }
+
+        replace_free_children(parent, space.free_list(), next_id_counter);
+        Network* allocated = add_child_block(parent, *block, next_id_counter);
+        subnets.sort_children(parent->id);
+
+        std::cout << "Name for " << get_net_str(allocated) << "/" << allocated->get_slash() << ": ";
+        std::string nm; std::getline(std::cin, nm);
+        if (!nm.empty()) allocated->set_name(nm);
+        std::cout << Color::GREEN << Icon::CHECK << " Allocated " << get_net_str(allocated) << "/" << allocated->get_slash() << "." << Color::RESET << "\n";
+    }
+    else if (action == 'M' || action == 'm') {
+        // Start from the split as it stands and free the unused children one by one;
+        // release() coalesces each with its free buddies
+        AddressSpace merged(parent);
+        std::vector<Cidr> unused;
+        for (int cid = subnets.get_first_child(parent->id); cid != 0; cid = subnets.get_next_sibling(cid)) {
+            Network* child = subnets.find(cid);
+            if (!child) continue;
+            Cidr block{(uint32_t)child->get_address(), child->get_slash()};
+            merged.claim(block);
+            if (!subnet_in_use(child)) unused.push_back(block);
+        }
+        for (const Cidr& block : unused) {
+            merged.release(block);
+        }
+
+        std::vector<Cidr> blocks = merged.free_list();
+        size_t free_children = unused.size();
+        if (blocks.size() == free_children) {
+            std::cout << "Nothing to merge.\n";
+        }
+        else if (blocks.size() == 1 && blocks[0].slash == parent->get_slash()) {
+            // Nothing in use below: undo the split entirely
+            replace_free_children(parent, {}, next_id_counter);
+            parent->set_split(false);
+            parent->set_assignment(SYMBOL_FREE);
+            std::cout << Color::GREEN << Icon::CHECK << " Merged back into " << get_net_str(parent) << "/" << parent->get_slash() << "." << Color::RESET << "\n";
+        } else {
+            replace_free_children(parent, blocks, next_id_counter);
+            subnets.sort_children(parent->id);
+            std::cout << Color::GREEN << Icon::CHECK << " Free children coalesced into " << blocks.size() << " block(s)." << Color::RESET << "\n";
+        }
+    }
+}
+
+// Parses "LAN A:50, LAN B:20, WAN:2" into planner requirements
+std::vector<Requirement> parse_requirements(const std::string& line) {
+    std::vector<Requirement> requirements;
+    std::stringstream ss(line);
+    std::string entry;
+    while (std::getline(ss, entry, ',')) {
+        trim(entry);
+        if (entry.empty()) continue;
+
+        size_t colon = entry.rfind(':');
+        if (colon == std::string::npos) {
+            std::cout << Color::YELLOW << Icon::WARN << " Skipping '" << entry << "' (expected name:hosts)." << Color::RESET << "\n";
+            continue;
+        }
+        std::string name = entry.substr(0, colon);
+        std::string hosts = entry.substr(colon + 1);
+        trim(name);
+        try {
+            int count = std::stoi(hosts);
+            if (count <= 0) throw std::invalid_argument("host count must be positive");
+            requirements.push_back({name, count});
+        } catch (...) {
+            std::cout << Color::YELLOW << Icon::WARN << " Skipping '" << entry << "' (invalid host count)." << Color::RESET << "\n";
+        }
+    }
+    return requirements;
+}
 
 std::string find_server_ip_for_relay(int server_router_id) {
     if (server_router_id < 0 || server_router_id >= (int)devices.size()) return "";
@@ -367,13 +529,15 @@ std::string find_server_ip_for_relay(int server_router_id) {
     if (server_dev->get_type() != DeviceType::ROUTER) return "";
 
     // Priority 1: Check if server is reachable via WAN (/30)
-    for (auto n : subnets) {
-        if (n->is_split) continue;
-        if (n->get_slash() == 30) {
-            std::string assign = n->get_assignment();
+    for (size_t i = 0; i < subnets.size(); i++) {
+        const NetworkCore& core = subnets.core_at(i);
+        const NetworkDetails& details = subnets.details_at(i);
+        if (core.flags & NETWORK_SPLIT) continue;
+        if (core.slash == 30) {
+            std::string assign = details.assignment_tag.str();
             // A. Server is the owner of this /30
             if (assign.find(server_dev->get_hostname()) != std::string::npos) {
-                return address_to_str(n->get_address() + 1);
+                return address_to_str(core.address + 1);
             }
             // B. Server is the peer (connected to owner)
             for(auto dev : devices) {
@@ -383,7 +547,7 @@ std::string find_server_ip_for_relay(int server_router_id) {
                         for(auto l : links) {
                             if((l->device1 == server_dev && l->device2 == dev) || 
                                (l->device1 == dev && l->device2 == server_dev)) {
-                                return address_to_str(n->get_address() + 2);
+                                return address_to_str(core.address + 2);
                             }
                         }
                     }
@@ -393,10 +557,12 @@ std::string find_server_ip_for_relay(int server_router_id) {
     }
 
     // Priority 2: Return any valid interface IP on the server
-    for (auto n : subnets) {
-        if (n->is_split) continue;
-        if (n->get_assignment().find(server_dev->get_hostname()) != std::string::npos) {
-            return address_to_str(n->get_address() + 1);
+    for (size_t i = 0; i < subnets.size(); i++) {
+        const NetworkCore& core = subnets.core_at(i);
+        const NetworkDetails& details = subnets.details_at(i);
+        if (core.flags & NETWORK_SPLIT) continue;
+        if (details.assignment_tag.str().find(server_dev->get_hostname()) != std::string::npos) {
+            return address_to_str(core.address + 1);
         }
     }
 
@@ -406,7 +572,7 @@ std::string find_server_ip_for_relay(int server_router_id) {
 void inspect_subnet(Network* n) {
     if(!n) return;
     std::cout << "\n" << Color::MAGENTA << "=== 🔍 Subnet Deep Inspection ===" << Color::RESET << "\n";
-    std::cout << "Name: " << Color::WHITE << (n->name.empty() ? "Unnamed" : n->name) << Color::RESET << "\n";
+    std::cout << "Name: " << Color::WHITE << (n->get_name().empty() ? "Unnamed" : n->get_name().str()) << Color::RESET << "\n";
     std::cout << "CIDR: " << Color::WHITE << "/" << n->get_slash() << Color::RESET << "\n";
     
     uint32_t net_addr = n->get_address();
@@ -432,11 +598,11 @@ void inspect_subnet(Network* n) {
         std::cout << " - Router0 (DCE): " << address_to_str(net_addr + 1) << "\n";
         std::cout << " - Router1 (DTE): " << address_to_str(net_addr + 2) << "\n";
     }
-    else if (n->dhcp_enabled && !n->dhcp_helper_ip.empty() && n->dhcp_upper_half_only) {
+    else if (n->get_dhcp_enabled() && !n->get_dhcp_helper_ip().empty() && n->get_dhcp_upper_half_only()) {
         // Relay / Upper Half
         std::cout << "Type: " << Color::CYAN << "LAN (DHCP Relay + Split Mode)" << Color::RESET << "\n";
         
-        uint32_t total_ips = (1 << (32 - n->get_slash())); // Includes net & bcast
+        uint32_t total_ips = prefix_block_size(n->get_slash()); // Includes net & bcast
         uint32_t half_point = net_addr + (total_ips / 2);
         
         // Static: Gateway (.1) to HalfPoint - 1
@@ -452,9 +618,9 @@ void inspect_subnet(Network* n) {
         
         std::cout << " - " << Color::GREEN << "DHCP Pool Range (Upper Half):" << Color::RESET << "\n";
         std::cout << "   " << address_to_str(dhcp_start) << " - " << address_to_str(dhcp_end) << "\n";
-        std::cout << "   (Assigned by Helper: " << n->dhcp_helper_ip << ")\n";
+        std::cout << "   (Assigned by Helper: " << n->get_dhcp_helper_ip() << ")\n";
     }
-    else if (!n->dhcp_enabled) {
+    else if (!n->get_dhcp_enabled()) {
         // Static LAN
         std::cout << "Type: " << Color::CYAN << "LAN (Fully Static)" << Color::RESET << "\n";
         
@@ -491,21 +657,14 @@ void menu_configure_subnets() {
             // Resume editing - skip base network wizard
             std::cout << Color::GREEN << Icon::CHECK << " Resuming existing configuration..." << Color::RESET << "\n";
             
-            // Find the highest existing ID for the counter
-            for (auto n : subnets) {
-                if (n->id >= next_id_counter) {
-                    next_id_counter = n->id + 1;
-                }
-            }
+            // Continue numbering above the highest existing ID
+            next_id_counter = subnets.next_id();
             // Jump directly to the interactive loop (handled below)
         } else {
             // Start new configuration
             std::cout << Color::YELLOW << Icon::WARN << " Starting new configuration. Clearing existing data..." << Color::RESET << "\n";
             
             // Clear existing subnets
-            for (auto n : subnets) {
-                delete n;
-            }
             subnets.clear();
             
             // Continue to base network wizard below
@@ -531,30 +690,79 @@ void menu_configure_subnets() {
             }
 
             Calculator calc(base_net);
-            std::cout << "Mode (N for Number of Subnets, H for Hosts per Subnet): ";
+            std::cout << "Mode (N for Number of Subnets, H for Hosts per Subnet, P for VLSM Plan, I to Import from file): ";
             char mode;
             std::cin >> mode; 
             clear_input();
             
             int req;
-            if (mode == 'H' || mode == 'h') {
+            std::shared_ptr<const SubnetTable> table;
+            if (mode == 'P' || mode == 'p') {
+                 std::cout << "Enter requirements as name:hosts, comma separated (e.g. LAN A:50, LAN B:20, WAN:2): ";
+                 std::string line;
+                 std::getline(std::cin, line);
+                 subnets = calc.plan_vlsm(parse_requirements(line));
+                 next_id_counter = subnets.next_id();
+                 std::cout << "Generated VLSM plan with " << subnets.size() << " subnets.\n";
+                 log_store_stats();
+                 return menu_configure_subnets_loop(next_id_counter);
+            } else if (mode == 'I' || mode == 'i') {
+                 std::cout << "File with one CIDR or address per line: ";
+                 std::string path;
+                 std::getline(std::cin, path);
+                 trim(path);
+                 CidrImport imported = import_cidr_file(path, std::max(1u, std::thread::hardware_concurrency()));
+                 if (!imported.error_lines.empty()) {
+                     std::cout << Color::YELLOW << Icon::WARN << " " << imported.error_lines.size()
+                               << " line(s) could not be parsed (first one is line " << imported.error_lines[0] << ")." << Color::RESET << "\n";
+                 }
+
+                 // Imported blocks become the subnets; overlaps and blocks outside the base are dropped
+                 AddressSpace space(base_net);
+                 std::vector<Cidr> blocks;
+                 for (const Cidr& block : imported.blocks) {
+                     Cidr aligned{block.address & prefix_mask(block.slash), block.slash};
+                     if (space.claim(aligned)) blocks.push_back(aligned);
+                 }
+                 size_t skipped = imported.blocks.size() - blocks.size();
+                 if (skipped > 0) {
+                     std::cout << Color::YELLOW << Icon::WARN << " " << skipped << " block(s) overlap or fall outside "
+                               << net_str << " and were skipped." << Color::RESET << "\n";
+                 }
+
+                 // The gaps between them stay as free subnets
+                 std::vector<Cidr> spare = space.free_list();
+                 blocks.insert(blocks.end(), spare.begin(), spare.end());
+                 std::sort(blocks.begin(), blocks.end(), [](const Cidr& a, const Cidr& b) { return a.address < b.address; });
+
+                 subnets.reserve(blocks.size());
+                 for (const Cidr& block : blocks) {
+                     Network* n = subnets.create(block);
+                     subnets.set_id(n, next_id_counter++);
+                 }
+                 std::cout << "Imported " << (blocks.size() - spare.size()) << " subnets (+" << spare.size() << " free block(s)).\n";
+                 log_store_stats();
+                 return menu_configure_subnets_loop(next_id_counter);
+            } else if (mode == 'H' || mode == 'h') {
                  std::cout << "Enter required hosts per subnet: ";
                  std::cin >> req; clear_input();
-                 subnets = calc.subnet_by_hosts(req);
+                 if (req <= 0) throw std::invalid_argument("Host count must be at least 1");
+                 table = calc.cached_subnet_by_hosts(req);
             } else {
                  std::cout << "Enter required number of subnets: ";
                  std::cin >> req; clear_input();
-                 subnets = calc.subnet_by_networks(req);
+                 table = calc.cached_subnet_by_networks(req);
             }
             
-            // Init IDs
-            for(auto n : subnets) {
-                n->id = next_id_counter++;
-                n->parent_id = 0;
-                n->children_ids.clear();
+            // Build the tree entries and init IDs
+            subnets.reserve(table->size());
+            for(size_t k = 0; k < table->size(); ++k) {
+                Network* n = table->to_network(k, subnets);
+                subnets.set_id(n, next_id_counter++);
             }
             
             std::cout << "Generated " << subnets.size() << " subnets.\n";
+            log_store_stats();
             
         } catch (const std::exception& e) {
             std::cout << "[ERROR] " << e.what() << "\n";
@@ -562,15 +770,19 @@ void menu_configure_subnets() {
         }
     }
 
-    // Interactive Loop
+    menu_configure_subnets_loop(next_id_counter);
+}
+
+// Interactive tree editor shared by the new and the resumed configuration
+void menu_configure_subnets_loop(int next_id_counter) {
     while (true) {
         std::cout << "\n--- Generated Subnets (Tree View) ---\n";
         printf("%-4s %-18s %-8s %-15s %s\n", "ID", "Network", "Hosts", "Name", "Status");
         
         // Print Tree
-        for (auto n : subnets) {
-            if (n->parent_id == 0) {
-                print_subnet_recursive(subnets, n, "");
+        for (size_t i = 0; i < subnets.size(); i++) {
+            if (subnets.get_parent(subnets.id_at(i)) == 0) {
+                print_subnet_tree(subnets, subnets[i]);
             }
         }
         
@@ -583,14 +795,14 @@ void menu_configure_subnets() {
         
         if (choice_id == 0) break;
         
-        Network* selected_net = get_net_by_id(subnets, choice_id);
+        Network* selected_net = subnets.find(choice_id);
         if (!selected_net) {
             std::cout << "Invalid ID.\n";
             continue;
         }
         
-        if (selected_net->is_split) {
-            std::cout << "[ERROR] This subnet has been split. Manage its children instead.\n";
+        if (selected_net->is_split()) {
+            manage_split_subnet(selected_net, next_id_counter);
             continue;
         }
 
@@ -611,7 +823,7 @@ void menu_configure_subnets() {
              std::cout << "Enter name for " << s_net << " (e.g. LAN A): ";
              std::string new_name;
              std::getline(std::cin, new_name);
-             selected_net->name = new_name;
+             selected_net->set_name(new_name);
              continue;
         }
         else if (action == 'S' || action == 's') {
@@ -621,40 +833,64 @@ void menu_configure_subnets() {
             int new_hosts;
             if (!(std::cin >> new_hosts)) { clear_input(); continue; }
             clear_input();
+            if (new_hosts <= 0) {
+                std::cout << "[ERROR] Host count must be at least 1.\n";
+                continue;
+            }
+
+            std::cout << "How many subnets of that size? (ENTER for as many as fit): ";
+            std::string count_str;
+            std::getline(std::cin, count_str);
+            trim(count_str);
 
             try {
-                Calculator sub_calc(selected_net);
-                std::vector<Network*> new_children = sub_calc.subnet_by_hosts(new_hosts);
-                
-                // Assign IDs and Link to Parent
-                for(auto child : new_children) {
-                    child->id = next_id_counter++;
-                    child->parent_id = selected_net->id;
-                    child->children_ids.clear();
-                    
-                    selected_net->children_ids.push_back(child->id);
+                int new_slash = IPV4_NET_BITS - Calculator::host_bits_for(new_hosts);
+                if (new_slash < selected_net->get_slash()) {
+                    std::cout << "[ERROR] " << s_net << "/" << selected_net->get_slash() << " can not hold " << new_hosts << " hosts.\n";
+                    continue;
                 }
+                long long wanted = count_str.empty() ? -1 : std::stoll(count_str);
+
+                // Carve the blocks out of the subnet; whatever is left stays as free buddy blocks
+                AddressSpace space(selected_net);
+                SubnetTable new_children;
+                uint32_t new_mask = prefix_mask(new_slash);
+                while (wanted < 0 || (long long)new_children.size() < wanted) {
+                    std::optional<Cidr> block = space.allocate(new_slash);
+                    if (!block) break;
+                    new_children.push_back(block->address, block->address | ~new_mask, new_slash);
+                }
+                std::vector<Cidr> spare = space.free_list();
                 
-                // Add new children to the main list
-                subnets.insert(subnets.end(), new_children.begin(), new_children.end());
-                
-                // Mark parent as split
-                selected_net->is_split = true;
-                selected_net->set_assignment("Split (VLSM Parent)");
-                
-                std::cout << "Successfully split into " << new_children.size() << " new subnets.\n";
+                std::cout << "Successfully split into " << new_children.size() << " new subnets";
+                if (!spare.empty()) std::cout << " (+" << spare.size() << " free block(s))";
+                std::cout << ".\n";
                 
                 std::cout << "Do you want to name these new subnets now? (y/n): ";
                 char c; std::cin >> c; clear_input();
                 if(c == 'y' || c == 'Y') {
                     for(size_t k = 0; k < new_children.size(); ++k) {
-                        std::string temp_net = get_net_str(new_children[k]);
-                        std::cout << "Name for " << temp_net << "/" << new_children[k]->get_slash() << ": ";
+                        std::string temp_net = address_to_str(new_children.get_address(k));
+                        std::cout << "Name for " << temp_net << "/" << new_children.get_slash(k) << ": ";
                         std::string nm; std::getline(std::cin, nm);
-                        if(!nm.empty()) new_children[k]->name = nm; 
+                        if(!nm.empty()) new_children.attach(k).name = nm; 
                     }
                 }
                 
+                // Assign IDs, link to parent and add the children to the main list
+                for(size_t k = 0; k < new_children.size(); ++k) {
+                    Network* child = new_children.to_network(k, subnets);
+                    subnets.set_id(child, next_id_counter++);
+                    subnets.add_child(selected_net->id, child->id);
+                }
+                for(const Cidr& block : spare) {
+                    add_child_block(selected_net, block, next_id_counter)->set_spare(true);
+                }
+                
+                // Mark parent as split
+                selected_net->set_split(true);
+                selected_net->set_assignment("Split (VLSM Parent)");
+                
             } catch (const std::exception& e) {
                 std::cout << "[ERROR] Splitting failed: " << e.what() << "\n";
             }
@@ -702,13 +938,13 @@ void menu_configure_subnets() {
                     if (!(std::cin >> vlan_assoc)) { clear_input(); vlan_assoc = 0; }
                     clear_input();
                     
-                    selected_net->associated_vlan_id = vlan_assoc;
+                    selected_net->set_associated_vlan_id(vlan_assoc);
                     
                     // Auto-naming from VLAN
-                    if (vlan_assoc > 0 && selected_net->name.empty()) {
+                    if (vlan_assoc > 0 && selected_net->get_name().empty()) {
                         if (VlanManager::vlan_exists(vlan_assoc)) {
-                            selected_net->name = VlanManager::get_vlan_name(vlan_assoc);
-                            std::cout << Color::GREEN << Icon::CHECK << " Auto-named: " << selected_net->name << Color::RESET << "\n";
+                            selected_net->set_name(VlanManager::get_vlan_name(vlan_assoc));
+                            std::cout << Color::GREEN << Icon::CHECK << " Auto-named: " << selected_net->get_name() << Color::RESET << "\n";
                         }
                     }
                     
@@ -734,7 +970,7 @@ void menu_configure_subnets() {
                     std::string manual_gw; std::getline(std::cin, manual_gw);
                     // trim(manual_gw); // trim helper not visible here, assume user input is clean or use simple check
                     if (!manual_gw.empty() && manual_gw.find_first_not_of(" \t") != std::string::npos) {
-                        selected_net->gateway_manual_ip = manual_gw;
+                        selected_net->set_gateway_manual_ip(manual_gw);
                         std::cout << Color::GREEN << "✅ Gateway Override: " << manual_gw << Color::RESET << "\n";
                         
                         // Also set on interface if found (complicated for subinterfaces, but let's try base interface)
@@ -742,7 +978,7 @@ void menu_configure_subnets() {
                         // Routers use subinterfaces struct.
                         // For now, storing in Network object is sufficient for guide generation.
                     } else {
-                        selected_net->gateway_manual_ip = ""; // Reset
+                        selected_net->set_gateway_manual_ip(""); // Reset
                     }
 
                     // DHCP Configuration (only for non-WAN subnets)
@@ -753,7 +989,7 @@ void menu_configure_subnets() {
                         std::cin >> dhcp_choice; clear_input();
                         
                         if (dhcp_choice == 'y' || dhcp_choice == 'Y') {
-                            selected_net->dhcp_enabled = true;
+                            selected_net->set_dhcp_enabled(true);
                             std::cout << Color::GREEN << Icon::CHECK << " DHCP enabled." << Color::RESET << "\n";
                             
                             // LOCAL or REMOTE DHCP Server
@@ -797,31 +1033,31 @@ void menu_configure_subnets() {
                                     std::cout << "Enter IP of Remote DHCP Server (for ip helper-address): ";
                                     std::string helper_ip;
                                     std::cin >> helper_ip; clear_input();
-                                    selected_net->dhcp_server_id = -1; 
-                                    selected_net->dhcp_helper_ip = helper_ip;
+                                    selected_net->set_dhcp_server_id(-1); 
+                                    selected_net->set_dhcp_helper_ip(helper_ip);
                                 } else {
                                      // Valid Remote Router Selected
-                                     selected_net->dhcp_server_id = remote_id;
+                                     selected_net->set_dhcp_server_id(remote_id);
                                      std::string auto_ip = find_server_ip_for_relay(remote_id);
                                      
                                      if(!auto_ip.empty()) {
-                                         selected_net->dhcp_helper_ip = auto_ip;
+                                         selected_net->set_dhcp_helper_ip(auto_ip);
                                          std::cout << Color::GREEN << "✅ Auto-Resolved Server IP: " << auto_ip << Color::RESET << "\n";
                                      } else {
                                          std::cout << Color::RED << "❌ Could not find an IP for Router " << candidate_routers[list_choice-1].second << ". Please enter manually." << Color::RESET << "\n";
                                          std::cout << "Enter IP: ";
                                          std::string helper_ip;
                                          std::cin >> helper_ip; clear_input();
-                                         selected_net->dhcp_helper_ip = helper_ip;
+                                         selected_net->set_dhcp_helper_ip(helper_ip);
                                      }
                                      
                                       std::cout << Color::YELLOW << Icon::WARN << " Centralized DHCP configured. " 
-                                          << "Helper-address: " << selected_net->dhcp_helper_ip << Color::RESET << "\n";
+                                          << "Helper-address: " << selected_net->get_dhcp_helper_ip() << Color::RESET << "\n";
                                 }
                             } else {
                                 // LOCAL DHCP Server
-                                selected_net->dhcp_server_id = current_router_idx;
-                                selected_net->dhcp_helper_ip = "";
+                                selected_net->set_dhcp_server_id(current_router_idx);
+                                selected_net->set_dhcp_helper_ip("");
                                 std::cout << Color::GREEN << Icon::CHECK << " DHCP served locally by " << rname << "." << Color::RESET << "\n";
                             }
                             
@@ -830,28 +1066,28 @@ void menu_configure_subnets() {
                             char half_choice;
                             std::cin >> half_choice; clear_input();
                             
-                            selected_net->dhcp_upper_half_only = (half_choice == 'y' || half_choice == 'Y');
-                            if (selected_net->dhcp_upper_half_only) {
+                            selected_net->set_dhcp_upper_half_only(half_choice == 'y' || half_choice == 'Y');
+                            if (selected_net->get_dhcp_upper_half_only()) {
                                 std::cout << Color::YELLOW << Icon::WARN << " Exam Mode: Lower half excluded." << Color::RESET << "\n";
                             }
                         } else {
                             // DHCP Disabled
-                            selected_net->dhcp_enabled = false;
-                            selected_net->dhcp_server_id = -1;
-                            selected_net->dhcp_helper_ip = "";
-                            selected_net->dhcp_upper_half_only = false;
+                            selected_net->set_dhcp_enabled(false);
+                            selected_net->set_dhcp_server_id(-1);
+                            selected_net->set_dhcp_helper_ip("");
+                            selected_net->set_dhcp_upper_half_only(false);
                             std::cout << "DHCP disabled (Static IPs).\n";
                         }
                     } else {
                         // WAN links - no DHCP
-                        selected_net->dhcp_enabled = false;
-                        selected_net->dhcp_server_id = -1;
-                        selected_net->dhcp_helper_ip = "";
-                        selected_net->dhcp_upper_half_only = false;
+                        selected_net->set_dhcp_enabled(false);
+                        selected_net->set_dhcp_server_id(-1);
+                        selected_net->set_dhcp_helper_ip("");
+                        selected_net->set_dhcp_upper_half_only(false);
                     }
                     
                     // Confirmation
-                    std::cout << Color::GREEN << Icon::CHECK << " Assigned " << selected_net->name 
+                    std::cout << Color::GREEN << Icon::CHECK << " Assigned " << selected_net->get_name() 
                               << " to " << rname << " " << final_iface << "." << Color::RESET << "\n";
                     
                 } else {
@@ -870,9 +1106,9 @@ void menu_configure_subnets() {
                     try { vid = std::stoi(v_input); } catch(...) {}
                     
                     // Default name to subnet name if available
-                    std::cout << "VLAN Name (e.g. DATA) [Default: " << (selected_net->name.empty() ? "VLAN"+v_input : selected_net->name) << "]: ";
+                    std::cout << "VLAN Name (e.g. DATA) [Default: " << (selected_net->get_name().empty() ? "VLAN"+v_input : selected_net->get_name().str()) << "]: ";
                     std::string vname; std::getline(std::cin, vname); // Use getline for empty check
-                    if (vname.empty()) vname = (selected_net->name.empty() ? "VLAN"+v_input : selected_net->name);
+                    if (vname.empty()) vname = (selected_net->get_name().empty() ? "VLAN"+v_input : selected_net->get_name().str());
                     
                     sw->add_vlan(vid, vname);
                     
@@ -885,7 +1121,7 @@ void menu_configure_subnets() {
                         // Calculate Smart Default: Last Usable
                         unsigned int net_addr = selected_net->get_address();
                         int cidr_slash = selected_net->get_slash();
-                        unsigned int broadcast = net_addr | ((1U << (32 - cidr_slash)) - 1);
+                        unsigned int broadcast = net_addr | prefix_wildcard(cidr_slash);
                         std::string default_mgmt = address_to_str(broadcast - 1);
                         
                         std::cout << "Default Management IP (Last Usable): " << default_mgmt << "\n";
@@ -954,11 +1190,11 @@ std::string normalize_interface(Device* dev, const std::string& assigned_iface)
     
     // Search for matching interface on device
     for (auto& iface : dev->interfaces) {
-        std::string iface_lower = iface.name;
+        std::string iface_lower = iface.name.str();
         std::transform(iface_lower.begin(), iface_lower.end(), iface_lower.begin(), ::tolower);
         
         if (!target_prefix.empty() && iface_lower.find(target_prefix) == 0) {
-            return iface.name; // Return actual interface name
+            return iface.name.str(); // Return actual interface name
         }
     }
     
@@ -966,39 +1202,6 @@ std::string normalize_interface(Device* dev, const std::string& assigned_iface)
     return base_iface;
 }
 
-// Helper: Calculate upper-half exclusion range
-void print_dhcp_exclusions(const std::string& network_ip, const std::string& mask_str) {
-    // Parse mask to CIDR
-    int cidr = 0;
-    unsigned int mask_int = 0;
-    {
-        int segments[4];
-        sscanf(mask_str.c_str(), "%d.%d.%d.%d", &segments[0], &segments[1], &segments[2], &segments[3]);
-        mask_int = (segments[0] << 24) | (segments[1] << 16) | (segments[2] << 8) | segments[3];
-    }
-    for (int i = 0; i < 32; ++i) {
-        if ((mask_int >> (31 - i)) & 1) cidr++;
-        else break;
-    }
-    
-    // Parse network to int
-    unsigned int net_int = 0;
-    {
-        int segments[4];
-        sscanf(network_ip.c_str(), "%d.%d.%d.%d", &segments[0], &segments[1], &segments[2], &segments[3]);
-        net_int = (segments[0] << 24) | (segments[1] << 16) | (segments[2] << 8) | segments[3];
-    }
-    
-    // Calculate midpoint
-    unsigned long long total_addresses = (1ULL << (32 - cidr));
-    unsigned int midpoint = total_addresses / 2;
-    unsigned int start_ex = net_int + 1;
-    unsigned int end_ex = net_int + midpoint - 1;
-    
-    std::cout << "ip dhcp excluded-address " << address_to_str(start_ex) << " " << address_to_str(end_ex) << "\n";
-}
-
-
 void menu_configure_security() {
     std::cout << "\n--- Configure Device Security ---\n";
     std::cout << "Select Device to configure:\n";
@@ -1084,6 +1287,12 @@ void load_exam_scenario() {
     }
 }
 
+// Golden exam subnets, checked at compile time
+constexpr Prefix EXAM_A = "192.168.1.32/27"_net;
+constexpr Prefix EXAM_B = "192.168.1.64/27"_net;
+constexpr Prefix EXAM_C = "192.168.1.96/27"_net;
+constexpr Prefix EXAM_D = "192.168.1.128/30"_net;
+
 void load_exam_template() {
     std::cout << Color::MAGENTA << "\n--- Load Golden Exam Scenario ---" << Color::RESET << "\n";
     std::cout << Color::YELLOW << Icon::WARN << " This will ERASE all current data and load the exam subnets!" << Color::RESET << "\n";
@@ -1106,7 +1315,6 @@ void load_exam_template() {
     devices.clear();
     for (auto l : links) delete l;
     links.clear();
-    for (auto n : subnets) delete n;
     subnets.clear();
     VlanManager::defined_vlans.clear();
     VlanManager::init();
@@ -1157,58 +1365,42 @@ void load_exam_template() {
     // 5. Define Golden Subnets
     
     // LAN A: 192.168.1.32/27, VLAN 10, DHCP via Router1
-    Network* lanA = new Network();
-    lanA->id = 1; lanA->name = "LAN A";
-    lanA->set_address(str_to_address("192.168.1.32"));
-    lanA->set_slash(27);
-    lanA->set_mask((~0u) << (32 - 27));
+    Network* lanA = subnets.create(EXAM_A.to_cidr());
+    subnets.set_id(lanA, 1); lanA->set_name("LAN A");
     lanA->set_assignment("Router0");
     lanA->set_assigned_interface("Gig0/1.10");
-    lanA->associated_vlan_id = 10;
-    lanA->dhcp_enabled = true;
-    lanA->dhcp_server_id = 1; // Served by Router1
-    lanA->dhcp_helper_ip = "192.168.1.130";
-    lanA->dhcp_upper_half_only = true;
-    subnets.push_back(lanA);
+    lanA->set_associated_vlan_id(10);
+    lanA->set_dhcp_enabled(true);
+    lanA->set_dhcp_server_id(1); // Served by Router1
+    lanA->set_dhcp_helper_ip("192.168.1.130");
+    lanA->set_dhcp_upper_half_only(true);
 
     // LAN B: 192.168.1.64/27, VLAN 20, DHCP via Router1
-    Network* lanB = new Network();
-    lanB->id = 2; lanB->name = "LAN B";
-    lanB->set_address(str_to_address("192.168.1.64"));
-    lanB->set_slash(27);
-    lanB->set_mask((~0u) << (32 - 27));
+    Network* lanB = subnets.create(EXAM_B.to_cidr());
+    subnets.set_id(lanB, 2); lanB->set_name("LAN B");
     lanB->set_assignment("Router0");
     lanB->set_assigned_interface("Gig0/1.20");
-    lanB->associated_vlan_id = 20;
-    lanB->dhcp_enabled = true;
-    lanB->dhcp_server_id = 1; // Served by Router1
-    lanB->dhcp_helper_ip = "192.168.1.130";
-    lanB->dhcp_upper_half_only = true;
-    subnets.push_back(lanB);
+    lanB->set_associated_vlan_id(20);
+    lanB->set_dhcp_enabled(true);
+    lanB->set_dhcp_server_id(1); // Served by Router1
+    lanB->set_dhcp_helper_ip("192.168.1.130");
+    lanB->set_dhcp_upper_half_only(true);
 
     // LAN C: 192.168.1.96/27, Physical LAN on Router1
-    Network* lanC = new Network();
-    lanC->id = 3; lanC->name = "LAN C";
-    lanC->set_address(str_to_address("192.168.1.96"));
-    lanC->set_slash(27);
-    lanC->set_mask((~0u) << (32 - 27));
+    Network* lanC = subnets.create(EXAM_C.to_cidr());
+    subnets.set_id(lanC, 3); lanC->set_name("LAN C");
     lanC->set_assignment("Router1");
     lanC->set_assigned_interface("Gig0/1");
-    lanC->associated_vlan_id = 1; // Physical
-    lanC->dhcp_enabled = false; // Static
-    subnets.push_back(lanC);
+    lanC->set_associated_vlan_id(1); // Physical
+    lanC->set_dhcp_enabled(false); // Static
 
     // LAN D (WAN): 192.168.1.128/30
-    Network* lanD = new Network();
-    lanD->id = 4; lanD->name = "LAN D";
-    lanD->set_address(str_to_address("192.168.1.128"));
-    lanD->set_slash(30);
-    lanD->set_mask((~0u) << (32 - 30));
+    Network* lanD = subnets.create(EXAM_D.to_cidr());
+    subnets.set_id(lanD, 4); lanD->set_name("LAN D");
     lanD->set_assignment("Router0");
     lanD->set_assigned_interface("Se0/1/0");
-    lanD->associated_vlan_id = 0;
-    lanD->dhcp_enabled = false;
-    subnets.push_back(lanD);
+    lanD->set_associated_vlan_id(0);
+    lanD->set_dhcp_enabled(false);
 
     // 6. Configure VLAN Port Assignments
     // Switch0 (Connects to Router0)
@@ -1244,34 +1436,36 @@ void show_network_overview() {
            Color::CYAN.c_str(), "ID", "Subnet Name", "IP Range", "VLAN", "Interface", "Gateway", "DHCP Config", Color::RESET.c_str());
     printf("-----|--------------|--------------------|----- -|------------|-----------------|-------------------\n");
     
-    for (auto n : subnets) {
+    for (size_t i = 0; i < subnets.size(); i++) {
+        const NetworkCore& core = subnets.core_at(i);
+        const NetworkDetails& details = subnets.details_at(i);
         // Skip parent nodes that have been split
-        if (n->is_split) continue;
+        if (core.flags & NETWORK_SPLIT) continue;
         
-        std::string ip_range = address_to_str(n->get_address()) + "/" + std::to_string(n->get_slash());
-        std::string vlan_str = n->associated_vlan_id > 0 ? std::to_string(n->associated_vlan_id) : "-";
-        std::string iface_str = n->get_assigned_interface().empty() ? "-" : n->get_assigned_interface();
-        std::string gateway = address_to_str(n->get_address() + 1);
+        std::string ip_range = address_to_str(core.address) + "/" + std::to_string(core.slash);
+        std::string vlan_str = details.associated_vlan_id > 0 ? std::to_string(details.associated_vlan_id) : "-";
+        std::string iface_str = details.assigned_interface.empty() ? "-" : details.assigned_interface.str();
+        std::string gateway = address_to_str(core.address + 1);
         
         // DHCP Config column
         std::string dhcp_cfg = "";
-        if (n->get_slash() >= 30) {
+        if (core.slash >= 30) {
             dhcp_cfg = "-";  // WAN links
-        } else if (!n->dhcp_enabled) {
+        } else if (!details.dhcp_enabled) {
             dhcp_cfg = "Static";
-        } else if (n->dhcp_helper_ip.empty()) {
+        } else if (details.dhcp_helper_ip.empty()) {
             dhcp_cfg = "Server (Local)";
         } else {
             dhcp_cfg = "Relay (Remote)";
         }
         
         // Color based on assignment status
-        std::string row_color = n->assignment_tag == "Free" ? Color::WHITE : Color::GREEN;
+        std::string row_color = details.assignment_tag == SYMBOL_FREE ? Color::WHITE : Color::GREEN;
         
         printf("%s%-4d | %-12s | %-18s | %-5s | %-10s | %-15s | %-18s%s\n",
                row_color.c_str(),
-               n->id,
-               n->name.empty() ? "(unnamed)" : n->name.substr(0, 12).c_str(),
+               subnets.id_at(i),
+               details.name.empty() ? "(unnamed)" : details.name.str().substr(0, 12).c_str(),
                ip_range.c_str(),
                vlan_str.c_str(),
                iface_str.substr(0, 10).c_str(),
@@ -1566,7 +1760,6 @@ void run_cli_mode() {
                         devices.clear();
                         for (auto l : links) delete l;
                         links.clear();
-                        for (auto n : subnets) delete n;
                         subnets.clear();
                         VlanManager::defined_vlans.clear();
                         VlanManager::init();
@@ -1625,12 +1818,14 @@ void run_cli_mode() {
                              if(router0_idx != -1 && router1_idx != -1) {
                                   // --- Router0 Logic ---
                                   // Add routes for subnets owned by Router1
-                                  for(auto n : subnets) {
-                                      if(n->get_assignment().find("Router1") != std::string::npos) {
+                                  for (size_t i = 0; i < subnets.size(); i++) {
+                                      const NetworkCore& core = subnets.core_at(i);
+                                      const NetworkDetails& details = subnets.details_at(i);
+                                      if(details.assignment_tag.str().find("Router1") != std::string::npos) {
                                           StaticRoute r;
                                           r.router_id = router0_idx;
-                                          r.dest_net = address_to_str(n->get_address());
-                                          r.mask = address_to_str(n->get_mask());
+                                          r.dest_net = address_to_str(core.address);
+                                          r.mask = address_to_str(core.mask);
                                           r.next_hop = "192.168.1.130"; // Hardcoded next-hop to R1 WAN
                                           static_routes.push_back(r);
                                       }
@@ -1638,13 +1833,15 @@ void run_cli_mode() {
                                   
                                   // --- Router1 Logic ---
                                   // Add routes for subnets owned by Router0
-                                  for(auto n : subnets) {
+                                  for (size_t i = 0; i < subnets.size(); i++) {
+                                      const NetworkCore& core = subnets.core_at(i);
+                                      const NetworkDetails& details = subnets.details_at(i);
                                      // Skip WAN link itself to avoid self-reference if assignment string matches partially, though usually fine
-                                      if(n->get_assignment().find("Router0") != std::string::npos && n->get_slash() != 30) {
+                                      if(details.assignment_tag.str().find("Router0") != std::string::npos && core.slash != 30) {
                                           StaticRoute r;
                                           r.router_id = router1_idx;
-                                          r.dest_net = address_to_str(n->get_address());
-                                          r.mask = address_to_str(n->get_mask());
+                                          r.dest_net = address_to_str(core.address);
+                                          r.mask = address_to_str(core.mask);
                                           r.next_hop = "192.168.1.129"; // Hardcoded next-hop to R0 WAN
                                           static_routes.push_back(r);
                                       }
@@ -1708,14 +1905,32 @@ void run_cli_mode() {
                          if(!valid) { std::cout << "Invalid Router ID.\n"; continue; }
                          
                          std::string dest, mask, hop;
-                         std::cout << "Destination Network (0.0.0.0 for Default): ";
+                         std::cout << "Destination Network (0.0.0.0 for Default; 10.0.0.0/8, a mask, a range or a whole 'ip route' line also work): ";
                          std::getline(std::cin, dest); trim(dest);
+                         std::optional<ParsedNetwork> parsed = parse_network(dest);
+                         if (!parsed) { std::cout << "[ERROR] Unrecognized network.\n"; continue; }
+                         dest = address_to_str(parsed->block.address);
                          
-                         std::cout << "Subnet Mask (0.0.0.0 for Default): ";
-                         std::getline(std::cin, mask); trim(mask);
+                         if (parsed->notation == Notation::Address) {
+                             std::cout << "Subnet Mask (0.0.0.0 for Default): ";
+                             std::getline(std::cin, mask); trim(mask);
+                             std::optional<uint32_t> mask_value = parse_ipv4(mask);
+                             if (!mask_value || mask_to_prefix(*mask_value) < 0) {
+                                 std::cout << "[ERROR] Invalid subnet mask " << mask << ".\n";
+                                 continue;
+                             }
+                         } else {
+                             mask = address_to_str(prefix_mask(parsed->block.slash));
+                         }
                          
-                         std::cout << "Next Hop IP Address: ";
-                         std::getline(std::cin, hop); trim(hop);
+                         if (parsed->next_hop != 0) {
+                             hop = address_to_str(parsed->next_hop);
+                         } else if (!parsed->exit_interface.empty()) {
+                             hop = parsed->exit_interface; // "ip route <net> <mask> <interface>" is written back as is
+                         } else {
+                             std::cout << "Next Hop IP Address: ";
+                             std::getline(std::cin, hop); trim(hop);
+                         }
                          
                          static_routes.push_back({rid, dest, mask, hop});
                          std::cout << Color::GREEN << "✅ Route Added." << Color::RESET << "\n";
@@ -1753,6 +1968,111 @@ void run_cli_mode() {
     }
 }
 
+// Non-interactive calculator: subnet --hosts N | --subnets N network
+// The console, or the --output file when one was given (exits if it can not be opened)
+std::ostream& results_output(Arguments* arguments, std::ofstream& file) {
+    if (arguments->get_output_path().empty()) {
+        return std::cout;
+    }
+
+    file.open(arguments->get_output_path(), std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        logger->error("Could not open [{}] for writing", arguments->get_output_path());
+        exit(1);
+    }
+    return file;
+}
+
+void run_calculator_mode(Arguments* arguments) {
+    // Machine readable formats keep stdout for the results alone
+    OutputFormat format = output_format_from_str(arguments->get_output_format()).value_or(OutputFormat::Table);
+    bool human = (format == OutputFormat::Table);
+    activate_logging(arguments->get_log_level(), arguments->get_log_queue_size(), arguments->get_log_drop_when_full(), !human);
+
+    // The parser owns the base network, so it lives for the whole run
+    std::optional<NetParser> parser;
+    try {
+        parser.emplace(arguments->get_str_network());
+    } catch (const std::invalid_argument& e) {
+        logger->error("{}", e.what());
+        exit(1);
+    }
+    Network* base = parser->get_network();
+    base->print_details();
+    if (human) {
+        std::cout << "\n";
+    }
+
+    Calculator calc(base);
+    std::ofstream file;
+
+    if (arguments->get_exact_subnets() > 0) {
+        ExactSplit split = calc.split_exact(arguments->get_exact_subnets(), arguments->get_equal_size());
+        std::ostream& out = results_output(arguments, file);
+        if (&out == &std::cout && human) {
+            std::cout << "\tIPv4 subnet by exact networks results\n";
+        }
+        show_results(split.subnets, out, format);
+        if (human) {
+            show_free_blocks(split.free_blocks, out);
+        } else {
+            for (const Cidr& block : split.free_blocks) {
+                logger->info("Free block: {}/{}", address_to_str(block.address), block.slash);
+            }
+        }
+        return;
+    }
+
+    std::string title;
+    SubnetRange results(base->get_address(), base->get_slash(), 0);
+    if (arguments->get_required_hosts() > 0) {
+        title = "\tIPv4 subnet by required hosts results";
+        results = calc.range_by_hosts(arguments->get_required_hosts());
+    } else if (arguments->get_required_subnets() > 0) {
+        title = "\tIPv4 subnet by required networks results";
+        results = calc.range_by_networks(arguments->get_required_subnets());
+    } else {
+        return;
+    }
+
+    if (arguments->get_summary()) {
+        std::ostream& out = results_output(arguments, file);
+        if (&out == &std::cout && human) {
+            std::cout << title << "\n";
+        }
+        show_summary(Calculator::summarize(results), out, format);
+        if (&out == &file) {
+            logger->info("Summary written to {}", arguments->get_output_path());
+        }
+        return;
+    }
+
+    if (!arguments->get_find_address().empty()) {
+        std::optional<uint32_t> address = parse_ipv4(arguments->get_find_address());
+        if (!address) {
+            logger->error("Invalid address [{}] for --find", arguments->get_find_address());
+            exit(1);
+        }
+        int64_t index = results.index_of(*address);
+        if (index < 0) {
+            logger->error("{} is not inside {}/{}", arguments->get_find_address(), get_net_str(base), base->get_slash());
+            exit(1);
+        }
+        results = results.page(index, 1);
+    } else {
+        results = results.page(arguments->get_offset(), arguments->get_limit());
+    }
+
+    std::ostream& out = results_output(arguments, file);
+    if (&out == &std::cout && human) {
+        std::cout << title << "\n";
+    }
+    show_results_parallel(results, out, arguments->get_threads(), format);
+    if (&out == &file) {
+        logger->info("Results written to {}", arguments->get_output_path());
+    }
+}
+
 int main(int argc, char* argv[]) {
     // Check arguments
     bool use_gui = false;
@@ -1768,6 +2088,15 @@ int main(int argc, char* argv[]) {
         // Load state for GUI too?
         StateManager::load(devices, links, subnets); // Pass subnets
         GuiLayer::run(devices, links);
+    } else if (argc > 1) {
+        run_calculator_mode(parse_arguments(argc, argv));
+        deactivate_logging();
+        if (dropped_log_messages() > 0) {
+            std::cerr << dropped_log_messages() << " log messages were dropped (async log queue full)\n";
+        }
+        if (truncated_log_messages() > 0) {
+            std::cerr << truncated_log_messages() << " log messages were truncated (longer than an async log slot)\n";
+        }
     } else {
         run_cli_mode();
     }
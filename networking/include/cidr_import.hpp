@@ -0,0 +1,21 @@
+#ifndef CIDR_IMPORT_HPP
+#define CIDR_IMPORT_HPP
+
+#include <network.hpp>
+#include <string>
+#include <vector>
+
+// Blocks read from a text file with one CIDR or address per line. Plain addresses
+// become /32 blocks; blank lines and lines starting with '#' are skipped.
+struct CidrImport
+{
+    std::vector<Cidr> blocks;           // in file order
+    size_t lines = 0;
+    std::vector<size_t> error_lines;    // 1-based numbers of the lines that did not parse
+};
+
+// Memory-maps the file, cuts it at line boundaries into one chunk per thread and
+// parses the chunks in parallel. Throws std::runtime_error if it can not be read.
+CidrImport import_cidr_file(const std::string& path, unsigned threads);
+
+#endif
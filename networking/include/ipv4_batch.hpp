@@ -0,0 +1,24 @@
+#ifndef IPV4_BATCH_HPP
+#define IPV4_BATCH_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+// Result of parsing many dotted-quad addresses: addresses[i] is only meaningful
+// when errors[i] is 0, and then it equals parse_ipv4(texts[i]).
+struct Ipv4Batch
+{
+    std::vector<uint32_t> addresses;
+    std::vector<uint8_t> errors;
+    size_t error_count = 0;
+};
+
+// Parses every address with the SSE4.1 parser when the CPU has it, or the scalar one
+Ipv4Batch parse_ipv4_batch(const std::string_view* texts, size_t count);
+Ipv4Batch parse_ipv4_batch(const std::vector<std::string_view>& texts);
+
+const char* ipv4_batch_parser_name();
+
+#endif
@@ -1,16 +1,50 @@
 #ifndef NETPARSER_HPP
 #define NETPARSER_HPP
 #include <network.hpp>
+#include <subnet_store.hpp>
+#include <optional>
 #include <string>
+#include <string_view>
 
+// Single pass parsers that never allocate. Octets must be 1 to 3 digits in [0, 255]
+// and the prefix 1 to 2 digits in [0, 32]; anything else (signs, spaces, missing
+// or extra parts) is rejected.
+std::optional<uint32_t> parse_ipv4(std::string_view text);
+std::optional<Cidr> parse_cidr(std::string_view text);
+
+// Prefix length of a contiguous mask (255.255.240.0) or wildcard (0.0.15.255), -1 if it has holes
+int mask_to_prefix(uint32_t mask);
+int wildcard_to_prefix(uint32_t wildcard);
+
+// The ways an operator may write a network
+enum class Notation
+{
+    Cidr,       // 10.0.0.0/8
+    Mask,       // 10.0.0.0 255.0.0.0
+    Wildcard,   // 10.0.0.0 0.255.255.255
+    Range,      // 10.0.0.0-10.0.3.255 (must be exactly one block)
+    IpRoute,    // ip route 10.0.0.0 255.0.0.0 192.168.1.1|Interface [distance]
+    Address     // 10.0.0.1, taken as a /32
+};
+
+struct ParsedNetwork
+{
+    Cidr block;
+    Notation notation;
+    uint32_t next_hop = 0;      // ip route only, 0 when it goes out an interface
+    std::string exit_interface; // ip route only, the interface when there is no next hop
+};
+
+// Recognizes any of the notations above; extra spaces are allowed between the parts
+std::optional<ParsedNetwork> parse_network(std::string_view text);
+
+// Parses the base network of a plan; the network lives as long as the parser
 class NetParser
 {
 private:
+    SubnetStore store;
     Network* network;
 
-    void assert_network(std::string str_net);
-    int parse_address(std::string str_net);
-    int extract_slash(std::string str_net);
     int parse_mask(int slash);
 
 public:
@@ -19,4 +53,4 @@ public:
     Network* get_network();
 };
 
-#endif
\ No newline at end of file
+#endif
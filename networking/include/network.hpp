@@ -2,68 +2,153 @@
 #define NETWORK_HPP
 #include <string>
 #include <vector>
+#include <memory>
+#include <cstdint>
+#include <string_view>
+#include <symbol.hpp>
 #define IPV4_NET_BITS 32
+#define IPV4_STR_SIZE 16    // "255.255.255.255" plus the terminating zero
 
+// Plain address block: network address plus prefix length
+struct Cidr
+{
+    uint32_t address;
+    int slash;
+};
+
+// Addressing core of a network: the only part scans over many subnets read.
+// A plain 16 byte record; SubnetStore keeps them in one array, so a scan over a
+// plan reads four subnets per cache line.
+struct NetworkCore
+{
+    uint32_t address;
+    uint32_t mask;
+    uint32_t broadcast;
+    uint8_t slash;
+    uint8_t flags;      // NETWORK_* bits
+    uint16_t reserved;
+};
+static_assert(sizeof(NetworkCore) == 16, "NetworkCore must stay 16 bytes");
+
+#define NETWORK_SPLIT 0x01  // divided into children (VLSM parent)
+#define NETWORK_SPARE 0x02  // free buddy block left over by a split or allocation
+
+// Names, assignment, DHCP and manual IP metadata. Rarely read, so SubnetStore keeps
+// it in a sparse column next to the cores and only allocates it the first time one
+// of its fields is set.
+struct NetworkDetails
+{
+    Symbol assignment_tag = SYMBOL_FREE;
+    Symbol assigned_interface;
+    Symbol name;
+    Symbol vlan_name = SYMBOL_DEFAULT;
+
+    // Manual IP Override
+    std::string manual_ip = "";         // If set, overrides default/DHCP assigned IP
+    std::string gateway_manual_ip = ""; // If set, overrides automatic gateway calculation
+
+    // VLAN Association
+    int associated_vlan_id = 0; // 0 = Physical/No VLAN
+
+    // DHCP Control Flags
+    bool dhcp_enabled = false;          // Whether to generate DHCP pool
+    bool dhcp_upper_half_only = false;  // Exam mode: exclude lower half
+    int dhcp_server_id = -1;            // ID of router serving DHCP (-1 = local/current)
+    std::string dhcp_helper_ip = "";    // IP address of remote DHCP server (for ip helper-address)
+};
+
+class SubnetStore;
+
+// Handle to one subnet of a SubnetStore: its core and details are the store's
+// columns at `slot`. Only the store creates, moves and destroys networks.
 class Network
 {
 private:
-    int address;
-    int mask;
-    int slash;
-    int broadcast;
+    SubnetStore* store;
+    uint32_t slot;
+
+    Network(SubnetStore* store, uint32_t slot);
+    friend class SubnetStore;
+
+    NetworkCore& core();
+    const NetworkCore& core() const;
+    // Details to read: the shared defaults until something was set
+    const NetworkDetails& read_details() const;
+    // Details to write, allocated on first use
+    NetworkDetails& write_details();
 
 public:
-    Network();
+    Network(const Network&) = delete;
+    Network& operator=(const Network&) = delete;
     void print_details();
 
     int get_address();
     int get_mask();
     int get_slash();
     int get_broadcast();
+    const NetworkCore& get_core() const { return core(); }
+    // Column index of this subnet in its store (changes when earlier subnets are removed)
+    size_t get_slot() const { return slot; }
 
     void set_address(int address);
     void set_mask(int mask);
     void set_slash(int slash);
     void set_broadcast(int broadcast);
 
+    bool is_split() const { return core().flags & NETWORK_SPLIT; }
+    void set_split(bool split);
+
+    bool is_spare() const { return core().flags & NETWORK_SPARE; }
+    void set_spare(bool spare);
+
+    // Whether any metadata was set (a bare block has none)
+    bool has_details() const;
+
     // Assignment Tag for UI
-    std::string assignment_tag = "Free";
-    std::string assigned_interface = "";
-    
-    void set_assignment(std::string tag) { assignment_tag = tag; }
-    std::string get_assignment() { return assignment_tag; }
-    
-    void set_assigned_interface(std::string iface) { assigned_interface = iface; }
-    std::string get_assigned_interface() { return assigned_interface; }
-
-    bool is_split = false;
-    std::string name = "";
-    std::string vlan_name = "default";
-    
-    // Manual IP Override
-    std::string manual_ip = ""; // If set, overrides default/DHCP assigned IP
+    Symbol get_assignment() const { return read_details().assignment_tag; }
+    void set_assignment(Symbol tag) { write_details().assignment_tag = tag; }
 
+    Symbol get_assigned_interface() const { return read_details().assigned_interface; }
+    void set_assigned_interface(Symbol iface) { write_details().assigned_interface = iface; }
 
-    // VLAN Association
-    int associated_vlan_id = 0; // 0 = Physical/No VLAN
+    Symbol get_name() const { return read_details().name; }
+    void set_name(Symbol name) { write_details().name = name; }
 
-    // DHCP Control Flags
-    bool dhcp_enabled = false;          // Whether to generate DHCP pool
-    bool dhcp_upper_half_only = false;  // Exam mode: exclude lower half
-    int dhcp_server_id = -1;            // ID of router serving DHCP (-1 = local/current)
-    std::string dhcp_helper_ip = "";    // IP address of remote DHCP server (for ip helper-address)
-    
-    // Manual IP Override
-    std::string gateway_manual_ip = ""; // If set, overrides automatic gateway calculation
+    Symbol get_vlan_name() const { return read_details().vlan_name; }
+    void set_vlan_name(Symbol vlan_name) { write_details().vlan_name = vlan_name; }
+
+    const std::string& get_manual_ip() const { return read_details().manual_ip; }
+    void set_manual_ip(std::string ip) { write_details().manual_ip = ip; }
+
+    const std::string& get_gateway_manual_ip() const { return read_details().gateway_manual_ip; }
+    void set_gateway_manual_ip(std::string ip) { write_details().gateway_manual_ip = ip; }
 
+    int get_associated_vlan_id() const { return read_details().associated_vlan_id; }
+    void set_associated_vlan_id(int vlan_id) { write_details().associated_vlan_id = vlan_id; }
 
-    // Hierarchy
+    bool get_dhcp_enabled() const { return read_details().dhcp_enabled; }
+    void set_dhcp_enabled(bool enabled) { write_details().dhcp_enabled = enabled; }
+
+    bool get_dhcp_upper_half_only() const { return read_details().dhcp_upper_half_only; }
+    void set_dhcp_upper_half_only(bool upper_half_only) { write_details().dhcp_upper_half_only = upper_half_only; }
+
+    int get_dhcp_server_id() const { return read_details().dhcp_server_id; }
+    void set_dhcp_server_id(int server_id) { write_details().dhcp_server_id = server_id; }
+
+    const std::string& get_dhcp_helper_ip() const { return read_details().dhcp_helper_ip; }
+    void set_dhcp_helper_ip(std::string ip) { write_details().dhcp_helper_ip = ip; }
+
+    // Set through SubnetStore::set_id, which indexes it; the store also keeps the hierarchy
     int id = 0;
-    int parent_id = 0; // 0 means root
-    std::vector<int> children_ids;
 };
 
 std::string address_to_str(int address);
+
+// Writes the dotted quad of `address` into `buffer` (at least IPV4_STR_SIZE bytes,
+// zero terminated) and returns a view of it; nothing is allocated
+std::string_view format_address(uint32_t address, char* buffer);
+// Same for a whole column: views[i] points into buffer + i * IPV4_STR_SIZE
+void format_address_column(const uint32_t* addresses, size_t count, char* buffer, std::string_view* views);
 unsigned int str_to_address(const std::string& ip);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef PREFIX_HPP
+#define PREFIX_HPP
+
+#include <network.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Everything that depends only on the prefix length, for /0 to /32
+struct PrefixInfo
+{
+    uint32_t mask;
+    uint32_t wildcard;
+    uint64_t block_size;    // addresses in the block, network and broadcast included
+    uint64_t host_count;    // usable hosts (block size minus network and broadcast)
+};
+
+constexpr std::array<PrefixInfo, IPV4_NET_BITS + 1> build_prefix_table()
+{
+    std::array<PrefixInfo, IPV4_NET_BITS + 1> table{};
+    for (int slash = 0; slash <= IPV4_NET_BITS; slash++)
+    {
+        uint64_t block = 1ULL << (IPV4_NET_BITS - slash);
+        table[slash].mask = (uint32_t)~(block - 1);
+        table[slash].wildcard = (uint32_t)(block - 1);
+        table[slash].block_size = block;
+        table[slash].host_count = (block > 2) ? block - 2 : 0;
+    }
+    return table;
+}
+
+inline constexpr std::array<PrefixInfo, IPV4_NET_BITS + 1> PREFIX_TABLE = build_prefix_table();
+
+constexpr uint32_t prefix_mask(int slash) { return PREFIX_TABLE[slash].mask; }
+constexpr uint32_t prefix_wildcard(int slash) { return PREFIX_TABLE[slash].wildcard; }
+constexpr uint64_t prefix_block_size(int slash) { return PREFIX_TABLE[slash].block_size; }
+
+// A network address and its prefix length, usable in constant expressions
+class Prefix
+{
+private:
+    uint32_t address;
+    int slash;
+
+public:
+    constexpr Prefix(uint32_t address, int slash) : address(address), slash(slash) {}
+
+    constexpr uint32_t get_address() const { return address; }
+    constexpr int get_slash() const { return slash; }
+    constexpr uint32_t get_mask() const { return prefix_mask(slash); }
+    constexpr uint32_t get_broadcast() const { return address | prefix_wildcard(slash); }
+    constexpr uint64_t get_host_count() const { return PREFIX_TABLE[slash].host_count; }
+    constexpr Cidr to_cidr() const { return Cidr{address, slash}; }
+};
+
+// "192.168.1.32/27"_net. The address must be the network address of the block;
+// in a constexpr variable any mistake is a compile error.
+constexpr Prefix operator""_net(const char* text, size_t length)
+{
+    uint32_t address = 0;
+    size_t pos = 0;
+    for (int octet = 0; octet < 4; octet++)
+    {
+        if (octet > 0 && (pos >= length || text[pos++] != '.'))
+            throw std::invalid_argument("_net: expected a dot");
+        unsigned value = 0;
+        size_t digits = 0;
+        for (; pos < length && text[pos] >= '0' && text[pos] <= '9'; pos++, digits++)
+            value = value * 10 + (text[pos] - '0');
+        if (digits == 0 || digits > 3 || value > 255)
+            throw std::invalid_argument("_net: invalid octet");
+        address = (address << 8) | value;
+    }
+
+    if (pos >= length || text[pos++] != '/')
+        throw std::invalid_argument("_net: expected /prefix");
+    int slash = 0;
+    size_t digits = 0;
+    for (; pos < length && text[pos] >= '0' && text[pos] <= '9'; pos++, digits++)
+        slash = slash * 10 + (text[pos] - '0');
+    if (digits == 0 || digits > 2 || slash > IPV4_NET_BITS || pos != length)
+        throw std::invalid_argument("_net: invalid prefix");
+
+    if (address & prefix_wildcard(slash))
+        throw std::invalid_argument("_net: host bits are set");
+    return Prefix(address, slash);
+}
+
+#endif
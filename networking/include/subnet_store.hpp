@@ -0,0 +1,130 @@
+#ifndef SUBNET_STORE_HPP
+#define SUBNET_STORE_HPP
+
+#include <network.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#define STORE_FIRST_CHUNK 64        // networks in the first arena chunk
+#define STORE_MAX_CHUNK 65536       // chunks double up to this many networks
+
+// Allocation figures of a SubnetStore, over its whole life (a store that is moved
+// into another one adds its counters to it)
+struct StoreStats
+{
+    uint64_t created = 0;       // networks constructed
+    uint64_t removed = 0;       // networks destroyed one at a time by remove()
+    uint64_t released = 0;      // networks dropped together by clear()
+    uint64_t chunks = 0;        // arena chunks allocated for the Network handles
+    size_t capacity = 0;        // networks the current chunks can hold
+};
+
+// Owns the subnets of a plan, as columns indexed by slot: a dense array of 16 byte
+// NetworkCore records, a sparse column of NetworkDetails (null until a field is set)
+// and the ids. Slots follow creation order and stay contiguous, as remove() closes
+// the gaps, so scans read core_at(i) for i < size() without touching a Network.
+//
+// The Network handles live in an arena of chunks that double in size, so they cost
+// one heap allocation per chunk instead of one per subnet and their addresses never
+// change (moving the store points them at the new one). clear() hands the arena back
+// chunk by chunk; arena slots freed by remove() are not reused until then.
+//
+// Subnets are also indexed by id: a dense table from id to network, kept up to date
+// by set_id() and remove(), makes find() O(1). Ids are never handed out twice, so
+// they stay valid while other subnets are split or removed.
+//
+// The hierarchy lives in the store too, as int32 arrays indexed by id: parent,
+// first child and next sibling (plus the last child, so appending is O(1)). 0 means
+// none, so roots have parent 0. Walking, removing or reordering a subtree touches
+// each of its nodes once and allocates nothing per node.
+class SubnetStore
+{
+private:
+    using Slot = std::aligned_storage_t<sizeof(Network), alignof(Network)>;
+
+    std::vector<Network*> items;                // items[slot]: handle of the subnet in that slot
+    std::vector<NetworkCore> cores;             // columns by slot
+    std::vector<std::unique_ptr<NetworkDetails>> details;
+    std::vector<int32_t> slot_ids;
+    std::vector<Network*> by_id;                // by_id[id]: subnet with that id, or null
+    std::vector<int32_t> parents;               // hierarchy links by id, 0 = none
+    std::vector<int32_t> first_children;
+    std::vector<int32_t> next_siblings;
+    std::vector<int32_t> last_children;
+    std::vector<std::unique_ptr<Slot[]>> chunks;
+    size_t chunk_size = 0;                      // slots in the last chunk
+    size_t chunk_used = 0;                      // slots taken in the last chunk
+    StoreStats stats;
+
+    void* allocate_slot();
+    Network* append(const NetworkCore& core);
+    void add_chunk(size_t slots);
+    int32_t link(const std::vector<int32_t>& links, int id) const
+    {
+        return (id >= 0 && (size_t)id < links.size()) ? links[id] : 0;
+    }
+    void relink_children(int parent, const std::vector<int>& children);
+
+    friend class Network;
+    inline static const NetworkDetails no_details{};
+
+public:
+    SubnetStore() = default;
+    SubnetStore(SubnetStore&& other) noexcept;
+    SubnetStore& operator=(SubnetStore&& other) noexcept;
+    SubnetStore(const SubnetStore&) = delete;
+    SubnetStore& operator=(const SubnetStore&) = delete;
+    ~SubnetStore();
+
+    // Appends a subnet with an empty core, or the block with its mask and broadcast
+    Network* create();
+    Network* create(Cidr block);
+
+    // Gives `network` (of this store) its id and indexes it; negative ids are not indexed.
+    // Call it before linking the subnet into the hierarchy. Throws std::invalid_argument
+    // if another subnet already has the id.
+    void set_id(Network* network, int id);
+    // Subnet with this id, or nullptr
+    Network* find(int id) const
+    {
+        return (id >= 0 && (size_t)id < by_id.size()) ? by_id[id] : nullptr;
+    }
+    // Lowest id above every id given so far (at least 1, as 0 marks the root)
+    int next_id() const { return by_id.size() > 1 ? (int)by_id.size() : 1; }
+
+    // Hierarchy by id; 0 when there is none
+    int get_parent(int id) const { return link(parents, id); }
+    int get_first_child(int id) const { return link(first_children, id); }
+    int get_next_sibling(int id) const { return link(next_siblings, id); }
+    // Appends `child`, which has no parent yet, to the children of `parent`. Both must
+    // be indexed and `parent` can not be below `child`; throws std::invalid_argument otherwise.
+    void add_child(int parent, int child);
+    // Puts the children of `parent` in address order
+    void sort_children(int parent);
+
+    // Destroys one subnet of this store together with everything below it
+    void remove(Network* network);
+    // Same for several subnets at once, in one pass over the store
+    void remove(const std::vector<Network*>& networks);
+    // Destroys every subnet and gives the arena back
+    void clear();
+    // Makes room for `count` more subnets with at most one allocation
+    void reserve(size_t count);
+
+    size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    Network* operator[](size_t slot) const { return items[slot]; }
+    // Columns by slot, for scans over the whole plan
+    const NetworkCore& core_at(size_t slot) const { return cores[slot]; }
+    const NetworkDetails& details_at(size_t slot) const { return details[slot] ? *details[slot] : no_details; }
+    int id_at(size_t slot) const { return slot_ids[slot]; }
+    std::vector<Network*>::const_iterator begin() const { return items.begin(); }
+    std::vector<Network*>::const_iterator end() const { return items.end(); }
+
+    const StoreStats& get_stats() const { return stats; }
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef SYMBOL_HPP
+#define SYMBOL_HPP
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+// Interned string: a 32 bit id into the process wide symbol table. Equal texts get
+// the same id, so comparing two symbols is an integer compare and every copy of a
+// repeated name ("Free", "default", "Fa0/1") costs 4 bytes. The text is only looked
+// up when it is printed.
+class Symbol
+{
+private:
+    uint32_t id;
+
+    constexpr explicit Symbol(uint32_t id, int) : id(id) {}
+
+public:
+    constexpr Symbol() : id(0) {}
+    Symbol(std::string_view text);
+    Symbol(const std::string& text) : Symbol(std::string_view(text)) {}
+    Symbol(const char* text) : Symbol(std::string_view(text)) {}
+
+    // Symbol of an id returned by get_id(); only for the ids reserved below
+    static constexpr Symbol from_id(uint32_t id) { return Symbol(id, 0); }
+    // Symbol of `text` if it was already interned, without adding it
+    static std::optional<Symbol> lookup(std::string_view text);
+    // Number of distinct texts interned so far
+    static size_t count();
+
+    uint32_t get_id() const { return id; }
+    const std::string& str() const;
+    bool empty() const { return id == 0; }
+
+    bool operator==(Symbol other) const { return id == other.id; }
+    bool operator!=(Symbol other) const { return id != other.id; }
+};
+
+// Interned up front, in this order, so their ids are constants
+constexpr Symbol SYMBOL_EMPTY = Symbol::from_id(0);     // ""
+constexpr Symbol SYMBOL_FREE = Symbol::from_id(1);      // "Free"
+constexpr Symbol SYMBOL_DEFAULT = Symbol::from_id(2);   // "default"
+
+std::ostream& operator<<(std::ostream& out, Symbol symbol);
+
+#endif
@@ -0,0 +1,164 @@
+#include <cidr_import.hpp>
+#include <netparser.hpp>
+#include <ipv4_batch.hpp>
+#include <logging.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Don't start a thread for less than this many bytes
+#define MIN_CHUNK_BYTES (64 * 1024)
+// Plain addresses handed to the batch parser at a time
+#define ADDRESS_BATCH 4096
+
+// Plain address lines waiting for the batch parser; their blocks are already in the
+// result, in file order, and get filled in when the batch is parsed
+struct PendingAddresses
+{
+    std::vector<std::string_view> texts;
+    std::vector<size_t> slots;      // index in result.blocks
+    std::vector<size_t> lines;
+};
+
+static void parse_pending(PendingAddresses& pending, CidrImport& result)
+{
+    Ipv4Batch batch = parse_ipv4_batch(pending.texts);
+    for (size_t i = 0; i < pending.texts.size(); i++)
+    {
+        if (batch.errors[i])
+        {
+            result.blocks[pending.slots[i]].slash = -1;     // dropped below
+            result.error_lines.push_back(pending.lines[i]);
+        }
+        else
+        {
+            result.blocks[pending.slots[i]].address = batch.addresses[i];
+        }
+    }
+    pending.texts.clear();
+    pending.slots.clear();
+    pending.lines.clear();
+}
+
+// Parses every line of `text` into `result`; error lines are counted from 1 within the chunk
+static void parse_chunk(std::string_view text, CidrImport& result)
+{
+    PendingAddresses pending;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = text.size();
+        std::string_view line = text.substr(pos, end - pos);
+        pos = end + 1;
+        result.lines++;
+
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t'))
+            line.remove_suffix(1);
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+            line.remove_prefix(1);
+        if (line.empty() || line.front() == '#')
+            continue;
+
+        if (line.find('/') != std::string_view::npos)
+        {
+            std::optional<Cidr> block = parse_cidr(line);
+            if (block)
+            {
+                result.blocks.push_back(*block);
+                continue;
+            }
+        }
+        else
+        {
+            pending.texts.push_back(line);
+            pending.slots.push_back(result.blocks.size());
+            pending.lines.push_back(result.lines);
+            result.blocks.push_back(Cidr{0, IPV4_NET_BITS});
+            if (pending.texts.size() == ADDRESS_BATCH)
+                parse_pending(pending, result);
+            continue;
+        }
+        result.error_lines.push_back(result.lines);
+    }
+    if (!pending.texts.empty())
+        parse_pending(pending, result);
+
+    // Errors in batched addresses were recorded out of line order
+    result.blocks.erase(std::remove_if(result.blocks.begin(), result.blocks.end(),
+        [](const Cidr& block) { return block.slash < 0; }), result.blocks.end());
+    std::sort(result.error_lines.begin(), result.error_lines.end());
+}
+
+CidrImport import_cidr_file(const std::string& path, unsigned threads)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Could not open [" + path + "]: " + strerror(errno));
+
+    struct stat info;
+    if (fstat(fd, &info) < 0)
+    {
+        close(fd);
+        throw std::runtime_error("Could not read [" + path + "]: " + strerror(errno));
+    }
+
+    CidrImport result;
+    size_t size = info.st_size;
+    if (size == 0)
+    {
+        close(fd);
+        return result;
+    }
+
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        throw std::runtime_error("Could not map [" + path + "]: " + strerror(errno));
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    std::string_view text((const char*)mapped, size);
+
+    // Cut points moved forward to the start of the next line, so no line is split
+    threads = std::max(1u, (unsigned)std::min<size_t>(threads, size / MIN_CHUNK_BYTES + 1));
+    std::vector<size_t> cuts(threads + 1, size);
+    cuts[0] = 0;
+    for (unsigned i = 1; i < threads; i++)
+    {
+        size_t newline = text.find('\n', std::max(cuts[i - 1], size * i / threads));
+        cuts[i] = (newline == std::string_view::npos) ? size : newline + 1;
+    }
+
+    std::vector<CidrImport> chunks(threads);
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; i++)
+        pool.emplace_back(parse_chunk, text.substr(cuts[i], cuts[i + 1] - cuts[i]), std::ref(chunks[i]));
+    parse_chunk(text.substr(0, cuts[1]), chunks[0]);
+    for (auto& t : pool)
+        t.join();
+    munmap(mapped, size);
+
+    // Concatenate the chunks in order, turning chunk line numbers into file line numbers
+    size_t total = 0;
+    for (const CidrImport& chunk : chunks)
+        total += chunk.blocks.size();
+    result.blocks.reserve(total);
+    for (const CidrImport& chunk : chunks)
+    {
+        result.blocks.insert(result.blocks.end(), chunk.blocks.begin(), chunk.blocks.end());
+        for (size_t line : chunk.error_lines)
+            result.error_lines.push_back(result.lines + line);
+        result.lines += chunk.lines;
+    }
+
+    LOG_INFO("Imported {} blocks from {} lines of [{}] ({} errors, {} threads)",
+        result.blocks.size(), result.lines, path, result.error_lines.size(), threads);
+    return result;
+}
@@ -0,0 +1,138 @@
+#include <ipv4_batch.hpp>
+#include <netparser.hpp>
+#include <cpu_features.hpp>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IPV4_BATCH_X86 1
+#endif
+
+// Longest valid address: 255.255.255.255
+#define IPV4_MAX_TEXT 15
+
+static void parse_batch_scalar(const std::string_view* texts, size_t count, Ipv4Batch& batch)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        std::optional<uint32_t> address = parse_ipv4(texts[i]);
+        batch.addresses[i] = address.value_or(0);
+        batch.errors[i] = !address;
+    }
+}
+
+#ifdef IPV4_BATCH_X86
+
+// Every address is 4 octets of 1 to 3 digits, so there are 3^4 = 81 layouts. For each
+// layout the shuffle moves the digits of octet i to bytes [4i, 4i + 3) right aligned
+// (hundreds, tens, units) and zeroes the rest, so one multiply-add gives the octets.
+typedef std::array<std::array<uint8_t, 16>, 81> ShuffleTable;
+
+static ShuffleTable build_shuffle_table()
+{
+    ShuffleTable table;
+    for (int layout = 0; layout < 81; layout++)
+    {
+        int lengths[4] = {layout / 27 + 1, layout / 9 % 3 + 1, layout / 3 % 3 + 1, layout % 3 + 1};
+        int start = 0;
+        for (int octet = 0; octet < 4; octet++)
+        {
+            for (int slot = 0; slot < 4; slot++)
+            {
+                int digit = slot - (3 - lengths[octet]);
+                table[layout][4 * octet + slot] = (slot < 3 && digit >= 0) ? start + digit : 0x80;
+            }
+            start += lengths[octet] + 1;
+        }
+    }
+    return table;
+}
+
+// One address per iteration: the dots are found with a compare + movemask, the
+// layout picks the shuffle and the octet values come out of two multiply-adds
+__attribute__((target("sse4.1")))
+static void parse_batch_sse41(const std::string_view* texts, size_t count, Ipv4Batch& batch)
+{
+    static const ShuffleTable shuffles = build_shuffle_table();
+    const __m128i zero_char = _mm_set1_epi8('0');
+    const __m128i dot_char = _mm_set1_epi8('.');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i tens = _mm_setr_epi8(100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0);
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i max_octet = _mm_set1_epi32(255);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t length = texts[i].size();
+        batch.addresses[i] = 0;
+        batch.errors[i] = 1;
+        if (length < 7 || length > IPV4_MAX_TEXT)
+            continue;
+
+        // Copy to a zeroed block so the load never reads past the end of the text
+        alignas(16) char buffer[16] = {0};
+        memcpy(buffer, texts[i].data(), length);
+        __m128i text = _mm_load_si128((const __m128i*)buffer);
+
+        unsigned used = (1u << length) - 1;
+        __m128i digits = _mm_sub_epi8(text, zero_char);
+        unsigned is_digit = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, nine), digits));
+        unsigned dots = _mm_movemask_epi8(_mm_cmpeq_epi8(text, dot_char)) & used;
+        if (((is_digit | dots) & used) != used || __builtin_popcount(dots) != 3)
+            continue;
+
+        // Octet lengths from the dot positions
+        int first_dot = __builtin_ctz(dots);
+        int second_dot = __builtin_ctz(dots & (dots - 1));
+        int third_dot = 31 - __builtin_clz(dots);
+        int lengths[4] = {first_dot, second_dot - first_dot - 1, third_dot - second_dot - 1, (int)length - third_dot - 1};
+        if (lengths[0] < 1 || lengths[0] > 3 || lengths[1] < 1 || lengths[1] > 3 ||
+            lengths[2] < 1 || lengths[2] > 3 || lengths[3] < 1 || lengths[3] > 3)
+            continue;
+        int layout = (lengths[0] - 1) * 27 + (lengths[1] - 1) * 9 + (lengths[2] - 1) * 3 + (lengths[3] - 1);
+
+        __m128i aligned = _mm_shuffle_epi8(digits, _mm_loadu_si128((const __m128i*)shuffles[layout].data()));
+        __m128i octets = _mm_madd_epi16(_mm_maddubs_epi16(aligned, tens), ones);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(octets, max_octet)))
+            continue;
+
+        __m128i packed = _mm_packus_epi16(_mm_packus_epi32(octets, octets), octets);
+        batch.addresses[i] = __builtin_bswap32((uint32_t)_mm_cvtsi128_si32(packed));
+        batch.errors[i] = 0;
+    }
+}
+
+#endif
+
+Ipv4Batch parse_ipv4_batch(const std::string_view* texts, size_t count)
+{
+    Ipv4Batch batch;
+    batch.addresses.resize(count);
+    batch.errors.resize(count);
+
+#ifdef IPV4_BATCH_X86
+    if (cpu_has_sse41())
+        parse_batch_sse41(texts, count, batch);
+    else
+#endif
+        parse_batch_scalar(texts, count, batch);
+
+    for (uint8_t error : batch.errors)
+        batch.error_count += error;
+    return batch;
+}
+
+Ipv4Batch parse_ipv4_batch(const std::vector<std::string_view>& texts)
+{
+    return parse_ipv4_batch(texts.data(), texts.size());
+}
+
+const char* ipv4_batch_parser_name()
+{
+#ifdef IPV4_BATCH_X86
+    if (cpu_has_sse41())
+        return "sse4.1";
+#endif
+    return "scalar";
+}
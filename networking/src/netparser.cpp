@@ -1,100 +1,290 @@
 #include <netparser.hpp>
+#include <prefix.hpp>
 #include <logging.hpp>
-#include <regex>
 #include <bitset>
+#include <array>
+#include <charconv>
 
-#define IPV4_NET_PATTERN "([0-9]+(.)){3}[0-9]+/[0-9]+"
+// Reads a decimal number of 1 to `max_digits` digits at `pos`, leaving `pos` after it
+static bool parse_number(std::string_view text, size_t& pos, size_t max_digits, unsigned& value)
+{
+    const char* first = text.data() + pos;
+    const char* last = text.data() + text.size();
+    if (first == last || *first < '0' || *first > '9')
+        return false;  // from_chars would also take a sign
 
+    std::from_chars_result result = std::from_chars(first, last, value);
+    size_t digits = result.ptr - first;
+    if (result.ec != std::errc() || digits > max_digits)
+        return false;
 
-NetParser::NetParser(std::string str_net)
+    pos += digits;
+    return true;
+}
+
+// Parses the four octets from the start of `text`, leaving `pos` after the last one
+static bool parse_octets(std::string_view text, size_t& pos, uint32_t& address)
 {
-    assert_network(str_net);
-    int address = parse_address(str_net);
-    int slash = extract_slash(str_net);
-    int mask = parse_mask(slash);
+    address = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        unsigned octet;
+        if (i > 0 && (pos >= text.size() || text[pos++] != '.'))
+            return false;
+        if (!parse_number(text, pos, 3, octet) || octet > 255)
+            return false;
+        address = (address << 8) | octet;
+    }
+    return true;
+}
 
-    Network* network = new Network();
-    network->set_address(address);
-    network->set_mask(mask);
-    network->set_slash(slash);
+std::optional<uint32_t> parse_ipv4(std::string_view text)
+{
+    size_t pos = 0;
+    uint32_t address;
+    if (!parse_octets(text, pos, address) || pos != text.size())
+        return std::nullopt;
+    return address;
+}
 
-    this->network = network;
+std::optional<Cidr> parse_cidr(std::string_view text)
+{
+    size_t pos = 0;
+    uint32_t address;
+    unsigned slash;
+    if (!parse_octets(text, pos, address) || pos >= text.size() || text[pos++] != '/')
+        return std::nullopt;
+    if (!parse_number(text, pos, 2, slash) || slash > IPV4_NET_BITS || pos != text.size())
+        return std::nullopt;
+    return Cidr{address, (int)slash};
 }
 
-Network* NetParser::get_network()
+int mask_to_prefix(uint32_t mask)
 {
-    return this->network;
+    // A contiguous mask has exactly as many ones as its prefix
+    int prefix = (mask == 0) ? 0 : IPV4_NET_BITS - __builtin_ctz(mask);
+    return (__builtin_popcount(mask) == prefix) ? prefix : -1;
 }
 
-void NetParser::assert_network(std::string str_net)
+int wildcard_to_prefix(uint32_t wildcard)
 {
-    logger->trace("Validating the [{}] string network...", str_net);
-    // Modified regex to strictly enforce CIDR suffix e.g. /24
-    std::regex pattern(IPV4_NET_PATTERN);
-    if (!std::regex_match(str_net, pattern))
+    return mask_to_prefix(~wildcard);
+}
+
+// Character classes driving the tokenizer
+enum CharClass : uint8_t
+{
+    CHAR_OTHER,
+    CHAR_DIGIT,
+    CHAR_DOT,
+    CHAR_SLASH,
+    CHAR_DASH,
+    CHAR_SPACE,
+    CHAR_ALPHA
+};
+
+static const std::array<uint8_t, 256> char_classes = []()
+{
+    std::array<uint8_t, 256> table{};
+    for (int c = '0'; c <= '9'; c++)
+        table[c] = CHAR_DIGIT;
+    for (int c = 'a'; c <= 'z'; c++)
+        table[c] = table[c - 'a' + 'A'] = CHAR_ALPHA;
+    table['.'] = CHAR_DOT;
+    table['/'] = CHAR_SLASH;
+    table['-'] = CHAR_DASH;
+    table[' '] = table['\t'] = table['\r'] = table['\n'] = CHAR_SPACE;
+    return table;
+}();
+
+enum TokenKind
+{
+    TOKEN_ADDRESS,  // a.b.c.d
+    TOKEN_PREFIX,   // /nn
+    TOKEN_NUMBER,   // bare number (route distance)
+    TOKEN_DASH,
+    TOKEN_WORD      // keyword or interface name
+};
+
+struct Token
+{
+    TokenKind kind;
+    uint32_t value;
+    std::string_view text;
+};
+
+#define MAX_TOKENS 8
+
+// Splits `text` into tokens in one pass; false on anything none of the notations use
+static bool tokenize(std::string_view text, Token* tokens, size_t& count)
+{
+    size_t pos = 0;
+    count = 0;
+    while (pos < text.size())
     {
-        logger->error("Error parsing network [{}]", str_net);
-        throw std::invalid_argument("Invalid Network Format (expected x.x.x.x/yy)");
+        uint8_t kind = char_classes[(unsigned char)text[pos]];
+        if (kind == CHAR_SPACE)
+        {
+            pos++;
+            continue;
+        }
+        if (count == MAX_TOKENS)
+            return false;
+
+        size_t start = pos;
+        Token& token = tokens[count++];
+        switch (kind)
+        {
+        case CHAR_DIGIT:
+        {
+            uint32_t address;
+            unsigned number;
+            if (parse_octets(text, pos, address))
+                token = Token{TOKEN_ADDRESS, address, {}};
+            else if (parse_number(text, pos = start, 3, number))
+                token = Token{TOKEN_NUMBER, number, {}};
+            else
+                return false;
+            // Something like 1.2.3.4x or 1.2.3.4.5 is not an address
+            if (pos < text.size() && (char_classes[(unsigned char)text[pos]] == CHAR_DIGIT ||
+                                      char_classes[(unsigned char)text[pos]] == CHAR_DOT ||
+                                      char_classes[(unsigned char)text[pos]] == CHAR_ALPHA))
+                return false;
+            break;
+        }
+        case CHAR_SLASH:
+        {
+            unsigned prefix;
+            pos++;
+            if (!parse_number(text, pos, 2, prefix) || prefix > IPV4_NET_BITS)
+                return false;
+            token = Token{TOKEN_PREFIX, prefix, {}};
+            break;
+        }
+        case CHAR_DASH:
+            pos++;
+            token = Token{TOKEN_DASH, 0, {}};
+            break;
+        case CHAR_ALPHA:
+            while (pos < text.size() && char_classes[(unsigned char)text[pos]] != CHAR_SPACE)
+                pos++;
+            token = Token{TOKEN_WORD, 0, text.substr(start, pos - start)};
+            break;
+        default:
+            return false;
+        }
     }
-    logger->trace("Network string [{}] OK", str_net);
+    return true;
+}
+
+static bool word_is(const Token& token, std::string_view word)
+{
+    if (token.kind != TOKEN_WORD || token.text.size() != word.size())
+        return false;
+    for (size_t i = 0; i < word.size(); i++)
+        if ((token.text[i] | 0x20) != word[i])
+            return false;
+    return true;
 }
 
-int NetParser::parse_address(std::string str_net)
-{
-    logger->trace("Parsing address to integer...");
-    int from_index = 0, point_index = 0;
-    int address = 0, segment = 24, value;
-    
-    // We expect exactly 3 dots for 4 octets.
-    // The previous loop condition 'point_index >= 0' combined with find logic was risky.
-    // Let's use a simpler tokenization loop.
-    
-    for(int i=0; i<4; ++i) {
-        if(i < 3) {
-            point_index = str_net.find(".", from_index);
-            if(point_index == std::string::npos) {
-                // Should be caught by regex, but safety first
-                throw std::invalid_argument("Invalid IP format: missing dots");
-            }
-            std::string part = str_net.substr(from_index, point_index - from_index);
-            value = atoi(part.c_str());
-            from_index = point_index + 1;
-        } else {
-            // Last octet is until the slash
-            point_index = str_net.find("/", from_index);
-            std::string part = str_net.substr(from_index, point_index - from_index);
-            value = atoi(part.c_str());
+std::optional<ParsedNetwork> parse_network(std::string_view text)
+{
+    Token tokens[MAX_TOKENS];
+    size_t count;
+    if (!tokenize(text, tokens, count) || count == 0)
+        return std::nullopt;
+
+    ParsedNetwork parsed;
+    const Token* t = tokens;
+
+    if (count == 1 && t[0].kind == TOKEN_ADDRESS)
+    {
+        parsed.block = Cidr{t[0].value, IPV4_NET_BITS};
+        parsed.notation = Notation::Address;
+        return parsed;
+    }
+    if (count == 2 && t[0].kind == TOKEN_ADDRESS && t[1].kind == TOKEN_PREFIX)
+    {
+        parsed.block = Cidr{t[0].value, (int)t[1].value};
+        parsed.notation = Notation::Cidr;
+        return parsed;
+    }
+    if (count == 2 && t[0].kind == TOKEN_ADDRESS && t[1].kind == TOKEN_ADDRESS)
+    {
+        // 0.0.0.0 and 255.255.255.255 are valid both ways; they are read as masks
+        int prefix = mask_to_prefix(t[1].value);
+        parsed.notation = Notation::Mask;
+        if (prefix < 0)
+        {
+            prefix = wildcard_to_prefix(t[1].value);
+            parsed.notation = Notation::Wildcard;
         }
-        
-        address |= (value << segment);
-        segment -= 8;
+        if (prefix < 0)
+            return std::nullopt;
+        parsed.block = Cidr{t[0].value, prefix};
+        return parsed;
     }
-    return address;
+    if (count == 3 && t[0].kind == TOKEN_ADDRESS && t[1].kind == TOKEN_DASH && t[2].kind == TOKEN_ADDRESS)
+    {
+        // first..last must be one aligned power-of-two block
+        uint32_t first = t[0].value, last = t[2].value;
+        int prefix = wildcard_to_prefix(first ^ last);
+        if (last < first || prefix < 0 || (first & (first ^ last)) != 0)
+            return std::nullopt;
+        parsed.block = Cidr{first, prefix};
+        parsed.notation = Notation::Range;
+        return parsed;
+    }
+    if ((count == 5 || count == 6) && word_is(t[0], "ip") && word_is(t[1], "route") &&
+        t[2].kind == TOKEN_ADDRESS && t[3].kind == TOKEN_ADDRESS &&
+        (t[4].kind == TOKEN_ADDRESS || t[4].kind == TOKEN_WORD))
+    {
+        // The only thing allowed after the next hop is the administrative distance
+        if (count == 6 && (t[5].kind != TOKEN_NUMBER || t[5].value < 1 || t[5].value > 255))
+            return std::nullopt;
+        int prefix = mask_to_prefix(t[3].value);
+        if (prefix < 0)
+            return std::nullopt;
+        parsed.block = Cidr{t[2].value, prefix};
+        parsed.notation = Notation::IpRoute;
+        if (t[4].kind == TOKEN_ADDRESS)
+            parsed.next_hop = t[4].value;
+        else
+            parsed.exit_interface = std::string(t[4].text);
+        return parsed;
+    }
+    return std::nullopt;
 }
 
-int NetParser::extract_slash(std::string str_net)
+
+NetParser::NetParser(std::string str_net)
 {
-    logger->trace("Extracting slash value...");
-    int slash_index = str_net.find("/") + 1;
-    logger->debug("slash_index={}", slash_index);
-    int slash = atoi(str_net.substr(slash_index).c_str());
-    logger->debug("slash_value={}", slash);
+    LOG_TRACE("Parsing the [{}] string network...", str_net);
+    std::optional<ParsedNetwork> parsed = parse_network(str_net);
+    if (!parsed || parsed->notation == Notation::Address)
+    {
+        LOG_ERROR("Error parsing network [{}]", str_net);
+        throw std::invalid_argument("Invalid Network Format (expected x.x.x.x/yy, x.x.x.x m.m.m.m or a range)");
+    }
+    Cidr block = parsed->block;
+    LOG_DEBUG("address={} slash_value={}", address_to_str(block.address), block.slash);
 
-    return slash;
+    Network* network = store.create();
+    network->set_address(block.address);
+    network->set_mask(parse_mask(block.slash));
+    network->set_slash(block.slash);
+
+    this->network = network;
+}
+
+Network* NetParser::get_network()
+{
+    return this->network;
 }
 
 int NetParser::parse_mask(int slash)
 {
-    logger->trace("Parsing slash value to mask integer bitset...");
-    int empty_bits = IPV4_NET_BITS - slash;
-    int mask = 0;
-    int bits = 0;
-    logger->debug("Number of empty bits: {}", empty_bits);
-    while(bits < empty_bits)
-        mask |= (1 << bits++);
-
-    logger->debug("Mask with empty bits defined : {}", std::bitset<IPV4_NET_BITS>(mask).to_string());
-    mask = ~mask;
-    logger->debug("Mask with NOT operand applied: {}", std::bitset<IPV4_NET_BITS>(mask).to_string());
+    int mask = prefix_mask(slash);
+    LOG_DEBUG("Mask for /{}: {}", slash, std::bitset<IPV4_NET_BITS>(mask).to_string());
     return mask;
 }
@@ -1,73 +1,154 @@
 #include <network.hpp>
+#include <subnet_store.hpp>
 #include <logging.hpp>
-#include <cstdio>
+#include <netparser.hpp>
+#include <array>
+#include <cstring>
 
-std::string address_to_str(int address)
+// Digits of every octet value, padded to 4 bytes so they are copied with one load/store
+struct OctetDigits
+{
+    char text[4];
+    uint8_t length;
+};
+
+static const std::array<OctetDigits, 256> octet_digits = []()
+{
+    std::array<OctetDigits, 256> table{};
+    for (int value = 0; value < 256; value++)
+    {
+        OctetDigits& entry = table[value];
+        if (value >= 100)
+            entry.text[entry.length++] = '0' + value / 100;
+        if (value >= 10)
+            entry.text[entry.length++] = '0' + value / 10 % 10;
+        entry.text[entry.length++] = '0' + value % 10;
+    }
+    return table;
+}();
+
+std::string_view format_address(uint32_t address, char* buffer)
 {
-    std::string str_address;
-    int bits = 24;
-    while(bits > -1)
+    size_t length = 0;
+    for (int bits = 24; bits >= 0; bits -= 8)
     {
-        str_address.append(std::to_string((address >> bits) & 255));
-        str_address.append((bits -= 8) > -1 ? "." : "");
+        // Copies all 4 bytes and only keeps `length`: the spare ones are overwritten
+        // by the next dot, and the last octet ends before byte 16
+        const OctetDigits& octet = octet_digits[(address >> bits) & 255];
+        memcpy(buffer + length, octet.text, 4);
+        length += octet.length;
+        buffer[length++] = '.';
     }
-    return str_address;
+    buffer[--length] = '\0';
+    return std::string_view(buffer, length);
+}
+
+void format_address_column(const uint32_t* addresses, size_t count, char* buffer, std::string_view* views)
+{
+    for (size_t i = 0; i < count; i++)
+        views[i] = format_address(addresses[i], buffer + i * IPV4_STR_SIZE);
+}
+
+std::string address_to_str(int address)
+{
+    char buffer[IPV4_STR_SIZE];
+    return std::string(format_address(address, buffer));
 }
 
 unsigned int str_to_address(const std::string& ip) {
-    int s[4];
-    if (sscanf(ip.c_str(), "%d.%d.%d.%d", &s[0], &s[1], &s[2], &s[3]) == 4) {
-        return (s[0] << 24) | (s[1] << 16) | (s[2] << 8) | s[3];
-    }
-    return 0;
+    return parse_ipv4(ip).value_or(0);
 }
 
 // Network class definition
 
-Network::Network() {}
+Network::Network(SubnetStore* store, uint32_t slot)
+{
+    this->store = store;
+    this->slot = slot;
+}
+
+NetworkCore& Network::core()
+{
+    return store->cores[slot];
+}
+
+const NetworkCore& Network::core() const
+{
+    return store->cores[slot];
+}
+
+const NetworkDetails& Network::read_details() const
+{
+    return store->details_at(slot);
+}
+
+NetworkDetails& Network::write_details()
+{
+    std::unique_ptr<NetworkDetails>& details = store->details[slot];
+    if (!details)
+        details = std::make_unique<NetworkDetails>();
+    return *details;
+}
+
+bool Network::has_details() const
+{
+    return store->details[slot] != nullptr;
+}
 
 void Network::print_details()
 {
-    logger->info("IP Address: {}/{}", address_to_str(this->address), slash);
-    logger->info("Mask: {}", address_to_str(this->mask));
+    LOG_INFO("IP Address: {}/{}", address_to_str(core().address), core().slash);
+    LOG_INFO("Mask: {}", address_to_str(core().mask));
 }
 
 int Network::get_address()
 {
-    return this->address;
+    return core().address;
 }
 
 int Network::get_mask()
 {
-    return this->mask;
+    return core().mask;
 }
 
 int Network::get_slash()
 {
-    return this->slash;
+    return core().slash;
 }
 
 int Network::get_broadcast()
 {
-    return this->broadcast;
+    return core().broadcast;
 }
 
 void Network::set_address(int address)
 {
-    this->address = address;
+    core().address = address;
 }
 
 void Network::set_mask(int mask)
 {
-    this->mask = mask;
+    core().mask = mask;
 }
 
 void Network::set_slash(int slash)
 {
-    this->slash = slash;
+    core().slash = slash;
 }
 
 void Network::set_broadcast(int broadcast)
 {
-    this->broadcast = broadcast;
+    core().broadcast = broadcast;
+}
+
+void Network::set_split(bool split)
+{
+    uint8_t& flags = core().flags;
+    flags = split ? (flags | NETWORK_SPLIT) : (flags & ~NETWORK_SPLIT);
+}
+
+void Network::set_spare(bool spare)
+{
+    uint8_t& flags = core().flags;
+    flags = spare ? (flags | NETWORK_SPARE) : (flags & ~NETWORK_SPARE);
 }
@@ -0,0 +1,281 @@
+#include <subnet_store.hpp>
+#include <prefix.hpp>
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+SubnetStore::SubnetStore(SubnetStore&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+SubnetStore& SubnetStore::operator=(SubnetStore&& other) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+        items = std::move(other.items);
+        cores = std::move(other.cores);
+        details = std::move(other.details);
+        slot_ids = std::move(other.slot_ids);
+        by_id = std::move(other.by_id);
+        parents = std::move(other.parents);
+        first_children = std::move(other.first_children);
+        next_siblings = std::move(other.next_siblings);
+        last_children = std::move(other.last_children);
+        chunks = std::move(other.chunks);
+        chunk_size = other.chunk_size;
+        chunk_used = other.chunk_used;
+        // The handles now read the columns of this store
+        for (Network* network : items)
+            network->store = this;
+        // The counters cover the life of this store, so they add up; the capacity is the
+        // arena this store now owns
+        stats.created += other.stats.created;
+        stats.removed += other.stats.removed;
+        stats.released += other.stats.released;
+        stats.chunks += other.stats.chunks;
+        stats.capacity = other.stats.capacity;
+
+        other.items.clear();
+        other.cores.clear();
+        other.details.clear();
+        other.slot_ids.clear();
+        other.by_id.clear();
+        other.parents.clear();
+        other.first_children.clear();
+        other.next_siblings.clear();
+        other.last_children.clear();
+        other.chunks.clear();
+        other.chunk_size = other.chunk_used = 0;
+        other.stats = StoreStats();
+    }
+    return *this;
+}
+
+SubnetStore::~SubnetStore()
+{
+    clear();
+}
+
+void SubnetStore::add_chunk(size_t slots)
+{
+    chunks.emplace_back(new Slot[slots]);
+    chunk_size = slots;
+    chunk_used = 0;
+    stats.chunks++;
+    stats.capacity += slots;
+}
+
+void* SubnetStore::allocate_slot()
+{
+    if (chunk_used == chunk_size)
+        add_chunk(std::min<size_t>(std::max<size_t>(STORE_FIRST_CHUNK, 2 * chunk_size), STORE_MAX_CHUNK));
+    return &chunks.back()[chunk_used++];
+}
+
+Network* SubnetStore::append(const NetworkCore& core)
+{
+    Network* network = new (allocate_slot()) Network(this, (uint32_t)items.size());
+    items.push_back(network);
+    cores.push_back(core);
+    details.emplace_back();
+    slot_ids.push_back(0);
+    stats.created++;
+    return network;
+}
+
+Network* SubnetStore::create()
+{
+    return append(NetworkCore{});
+}
+
+Network* SubnetStore::create(Cidr block)
+{
+    NetworkCore core{};
+    core.address = block.address;
+    core.slash = block.slash;
+    core.mask = prefix_mask(block.slash);
+    core.broadcast = core.address | ~core.mask;
+    return append(core);
+}
+
+void SubnetStore::set_id(Network* network, int id)
+{
+    Network* holder = find(id);
+    if (holder && holder != network)
+        throw std::invalid_argument("Subnet id " + std::to_string(id) + " is already taken");
+    if (find(network->id) == network)
+        by_id[network->id] = nullptr;
+    network->id = id;
+    slot_ids[network->slot] = id;
+    if (id < 0)
+        return;
+    if ((size_t)id >= by_id.size())
+    {
+        size_t size = (size_t)id + 1;
+        by_id.resize(size, nullptr);
+        parents.resize(size, 0);
+        first_children.resize(size, 0);
+        next_siblings.resize(size, 0);
+        last_children.resize(size, 0);
+    }
+    by_id[id] = network;
+}
+
+void SubnetStore::add_child(int parent, int child)
+{
+    bool valid = find(parent) && find(child) && parents[child] == 0;
+    // A subnet can not end up below itself, so walks over the tree always end
+    for (int up = parent; valid && up != 0; up = parents[up])
+        valid = up != child;
+    if (!valid)
+        throw std::invalid_argument("Subnet " + std::to_string(child) + " can not be added below " + std::to_string(parent));
+
+    parents[child] = parent;
+    next_siblings[child] = 0;
+    if (last_children[parent] != 0)
+        next_siblings[last_children[parent]] = child;
+    else
+        first_children[parent] = child;
+    last_children[parent] = child;
+}
+
+void SubnetStore::relink_children(int parent, const std::vector<int>& children)
+{
+    first_children[parent] = children.empty() ? 0 : children.front();
+    last_children[parent] = children.empty() ? 0 : children.back();
+    for (size_t i = 0; i < children.size(); i++)
+        next_siblings[children[i]] = i + 1 < children.size() ? children[i + 1] : 0;
+}
+
+void SubnetStore::sort_children(int parent)
+{
+    if (!find(parent))
+        return;
+    std::vector<int> children;
+    for (int child = first_children[parent]; child != 0; child = next_siblings[child])
+        children.push_back(child);
+    std::stable_sort(children.begin(), children.end(), [this](int a, int b) {
+        return cores[by_id[a]->slot].address < cores[by_id[b]->slot].address;
+    });
+    relink_children(parent, children);
+}
+
+void SubnetStore::remove(Network* network)
+{
+    remove(std::vector<Network*>{network});
+}
+
+void SubnetStore::remove(const std::vector<Network*>& networks)
+{
+    // Every id going away: the given subnets and their subtrees
+    std::vector<int> ids;
+    std::vector<int> pending;
+    for (Network* network : networks)
+        if (find(network->id) == network)
+            pending.push_back(network->id);
+    while (!pending.empty())
+    {
+        int id = pending.back();
+        pending.pop_back();
+        ids.push_back(id);
+        for (int child = first_children[id]; child != 0; child = next_siblings[child])
+            pending.push_back(child);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    auto removed = [&ids](int id) { return std::binary_search(ids.begin(), ids.end(), id); };
+
+    // Drop them from the child lists of the parents that stay, one pass per parent
+    std::vector<int> kept_parents;
+    for (int id : ids)
+        if (parents[id] != 0 && !removed(parents[id]))
+            kept_parents.push_back(parents[id]);
+    std::sort(kept_parents.begin(), kept_parents.end());
+    kept_parents.erase(std::unique(kept_parents.begin(), kept_parents.end()), kept_parents.end());
+    std::vector<int> children;
+    for (int parent : kept_parents)
+    {
+        children.clear();
+        for (int child = first_children[parent]; child != 0; child = next_siblings[child])
+            if (!removed(child))
+                children.push_back(child);
+        relink_children(parent, children);
+    }
+
+    // The tables keep their size, so next_id() never gives the ids out again
+    std::vector<Network*> doomed(networks);
+    for (int id : ids)
+    {
+        doomed.push_back(by_id[id]);
+        by_id[id] = nullptr;
+        parents[id] = first_children[id] = next_siblings[id] = last_children[id] = 0;
+    }
+    std::sort(doomed.begin(), doomed.end());
+
+    // Close the gaps so the columns stay dense and in creation order
+    size_t kept = 0;
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        Network* network = items[i];
+        if (std::binary_search(doomed.begin(), doomed.end(), network))
+        {
+            network->~Network();
+            stats.removed++;
+            continue;
+        }
+        if (kept != i)
+        {
+            items[kept] = network;
+            cores[kept] = cores[i];
+            details[kept] = std::move(details[i]);
+            slot_ids[kept] = slot_ids[i];
+            network->slot = (uint32_t)kept;
+        }
+        kept++;
+    }
+    items.resize(kept);
+    cores.resize(kept);
+    details.resize(kept);
+    slot_ids.resize(kept);
+}
+
+void SubnetStore::clear()
+{
+    // The handles own no memory and bare subnets have no details, so the heap only
+    // sees one free per chunk and one per subnet with metadata
+    for (Network* network : items)
+        network->~Network();
+    stats.released += items.size();
+
+    items.clear();
+    cores.clear();
+    details.clear();
+    slot_ids.clear();
+    by_id.clear();
+    parents.clear();
+    first_children.clear();
+    next_siblings.clear();
+    last_children.clear();
+    chunks.clear();
+    chunk_size = chunk_used = 0;
+    stats.capacity = 0;
+}
+
+void SubnetStore::reserve(size_t count)
+{
+    items.reserve(items.size() + count);
+    cores.reserve(cores.size() + count);
+    details.reserve(details.size() + count);
+    slot_ids.reserve(slot_ids.size() + count);
+    size_t ids = by_id.size() + count + 1;
+    by_id.reserve(ids);
+    parents.reserve(ids);
+    first_children.reserve(ids);
+    next_siblings.reserve(ids);
+    last_children.reserve(ids);
+    if (chunk_size - chunk_used < count)
+        add_chunk(std::max<size_t>(count, STORE_FIRST_CHUNK));
+}
@@ -0,0 +1,111 @@
+#include <symbol.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#define SYMBOL_FIRST_CHUNK 64   // texts in chunk 0; every next chunk is twice as big
+#define SYMBOL_CHUNKS 27        // enough chunks for every 32 bit id
+
+// Texts live in chunks that are never moved or freed, so the strings (and the views
+// keying the map) stay put. Only intern() and find() take the lock: whoever holds a
+// symbol got its id after the text was stored, so text() reads it without locking.
+class SymbolTable
+{
+private:
+    std::mutex lock;
+    std::atomic<std::string*> chunks[SYMBOL_CHUNKS] = {};
+    uint32_t used = 0;
+    std::unordered_map<std::string_view, uint32_t> ids;
+
+    // Chunk c holds the ids from SYMBOL_FIRST_CHUNK * (2^c - 1) on
+    static int chunk_of(uint32_t id) { return 31 - __builtin_clz(id / SYMBOL_FIRST_CHUNK + 1); }
+    static uint32_t chunk_start(int chunk) { return SYMBOL_FIRST_CHUNK * ((1u << chunk) - 1); }
+
+public:
+    SymbolTable()
+    {
+        for (std::string_view text : {"", "Free", "default"})
+            intern(text);
+    }
+
+    ~SymbolTable()
+    {
+        for (int c = 0; c < SYMBOL_CHUNKS; c++)
+            delete[] chunks[c].load(std::memory_order_relaxed);
+    }
+
+    uint32_t intern(std::string_view text)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = ids.find(text);
+        if (it != ids.end())
+            return it->second;
+
+        uint32_t id = used;
+        int chunk = chunk_of(id);
+        std::string* slots = chunks[chunk].load(std::memory_order_relaxed);
+        if (!slots)
+        {
+            slots = new std::string[SYMBOL_FIRST_CHUNK << chunk];
+            chunks[chunk].store(slots, std::memory_order_release);
+        }
+        std::string& stored = slots[id - chunk_start(chunk)];
+        stored.assign(text.data(), text.size());
+        ids.emplace(stored, id);
+        used++;
+        return id;
+    }
+
+    std::optional<uint32_t> find(std::string_view text)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = ids.find(text);
+        if (it == ids.end())
+            return std::nullopt;
+        return it->second;
+    }
+
+    const std::string& text(uint32_t id) const
+    {
+        int chunk = chunk_of(id);
+        return chunks[chunk].load(std::memory_order_acquire)[id - chunk_start(chunk)];
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return used;
+    }
+};
+
+static SymbolTable& symbol_table()
+{
+    static SymbolTable table;
+    return table;
+}
+
+Symbol::Symbol(std::string_view text) : id(symbol_table().intern(text)) {}
+
+std::optional<Symbol> Symbol::lookup(std::string_view text)
+{
+    std::optional<uint32_t> id = symbol_table().find(text);
+    if (!id)
+        return std::nullopt;
+    return Symbol::from_id(*id);
+}
+
+size_t Symbol::count()
+{
+    return symbol_table().size();
+}
+
+const std::string& Symbol::str() const
+{
+    return symbol_table().text(id);
+}
+
+std::ostream& operator<<(std::ostream& out, Symbol symbol)
+{
+    return out << symbol.str();
+}
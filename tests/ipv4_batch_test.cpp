@@ -0,0 +1,59 @@
+// Differential test: parse_ipv4_batch (the SSE4.1 parser when the CPU has it) must
+// accept exactly the texts parse_ipv4 accepts, and give the same address for them.
+#include <ipv4_batch.hpp>
+#include <netparser.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#define TEST_RANDOM_TEXTS 200000    // random valid and random garbage texts each
+
+int main()
+{
+    std::vector<std::string> texts = {
+        "0.0.0.0", "255.255.255.255", "1.2.3.4", "10.0.0.1", "192.168.100.200", "100.10.1.0",
+        "001.002.003.004", "9.99.199.255", "256.0.0.0", "0.0.0.256", "1.2.3.999", "300.1.1.1",
+        ".1.2.3", "1.2.3.", "1..2.3", "1.2.3.4.5", "1.2.3", "1234.1.1.1", "1.2.3.4 ", " 1.2.3.4",
+        "1.2.3.a", "a.b.c.d", "1.2.3.-4", "+1.2.3.4", "", ".", "...", "1.2.3.4/24", "0000.0.0.0",
+        "255.255.255.2555", "1.1.1.1111",
+    };
+
+    std::mt19937 random(12345);
+    std::uniform_int_distribution<int> octet(0, 255);
+    std::uniform_int_distribution<int> length(0, 17);
+    const char alphabet[] = "0123456789..x";
+    std::uniform_int_distribution<int> letter(0, sizeof(alphabet) - 2);
+    for (int i = 0; i < TEST_RANDOM_TEXTS; i++)
+    {
+        texts.push_back(std::to_string(octet(random)) + "." + std::to_string(octet(random)) + "." +
+                        std::to_string(octet(random)) + "." + std::to_string(octet(random)));
+        std::string garbage(length(random), ' ');
+        for (char& c : garbage)
+            c = alphabet[letter(random)];
+        texts.push_back(garbage);
+    }
+
+    std::vector<std::string_view> views(texts.begin(), texts.end());
+    Ipv4Batch batch = parse_ipv4_batch(views);
+
+    int failures = 0;
+    size_t accepted = 0;
+    for (size_t i = 0; i < views.size(); i++)
+    {
+        std::optional<uint32_t> expected = parse_ipv4(views[i]);
+        bool ok = expected ? (batch.errors[i] == 0 && batch.addresses[i] == *expected) : batch.errors[i] != 0;
+        if (!ok)
+        {
+            if (failures < 10)
+                std::printf("%s: [%s] differs from parse_ipv4\n", ipv4_batch_parser_name(), texts[i].c_str());
+            failures++;
+        }
+        accepted += expected.has_value();
+    }
+
+    std::printf("%s: %zu texts checked (%zu valid), %d failed\n", ipv4_batch_parser_name(), views.size(), accepted,
+                failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+// Re-inserting a cached query must replace its table and keep the row count exact,
+// and tables evicted by either bound must leave the count consistent.
+#include <result_cache.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+static std::shared_ptr<const SubnetTable> make_table(size_t rows)
+{
+    auto table = std::make_shared<SubnetTable>();
+    for (size_t i = 0; i < rows; i++)
+        table->push_back((uint32_t)(i << 2), (uint32_t)(i << 2) | 3, 30);
+    return table;
+}
+
+static int check(bool ok, const char* what)
+{
+    if (!ok)
+        std::printf("failed: %s\n", what);
+    return ok ? 0 : 1;
+}
+
+int main()
+{
+    int failures = 0;
+    ResultCache cache(4, 100);
+    QueryKey first{0x0A000000u, 24, SplitMode::Networks, 64};
+    QueryKey second{0x0A000000u, 24, SplitMode::Hosts, 2};
+
+    cache.insert(first, make_table(10));
+    cache.insert(second, make_table(20));
+    cache.insert(first, make_table(30));
+    failures += check(cache.size() == 2, "re-inserted key is stored once");
+    failures += check(cache.get_rows() == 50, "re-inserted key replaces its rows");
+    failures += check(cache.find(first) && cache.find(first)->size() == 30, "re-inserted key returns the new table");
+
+    // Over the row budget: the replacement is not cached and the old table is gone
+    cache.insert(first, make_table(101));
+    failures += check(cache.size() == 1 && cache.get_rows() == 20, "oversized replacement drops the key");
+    failures += check(cache.find(first) == nullptr, "oversized replacement is not cached");
+
+    // The row budget evicts the least recently used table
+    cache.insert(first, make_table(90));
+    failures += check(cache.size() == 1 && cache.get_rows() == 90, "row budget evicts the oldest table");
+    failures += check(cache.find(second) == nullptr, "evicted table is gone");
+
+    std::printf("%d cache checks failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
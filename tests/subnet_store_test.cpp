@@ -0,0 +1,75 @@
+// SubnetStore keeps its lifetime counters when another store is moved into it,
+// never lets two subnets share an id and keeps its columns dense.
+#include <subnet_store.hpp>
+#include <cstdio>
+#include <stdexcept>
+
+static int check(bool ok, const char* what)
+{
+    if (!ok)
+        std::printf("failed: %s\n", what);
+    return ok ? 0 : 1;
+}
+
+int main()
+{
+    int failures = 0;
+
+    SubnetStore store;
+    store.set_id(store.create(Cidr{0x0A000000u, 8}), 1);
+    store.set_id(store.create(Cidr{0x0A000000u, 9}), 2);
+
+    Network* taken = store.create(Cidr{0x0A800000u, 9});
+    bool threw = false;
+    try
+    {
+        store.set_id(taken, 2);
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    failures += check(threw, "set_id rejects an id that is taken");
+    failures += check(store.find(2) && store.find(2)->get_slash() == 9 && store.find(2) != taken,
+                      "the first subnet keeps its id");
+    store.set_id(taken, 3);
+    store.set_id(taken, 3);
+    failures += check(store.find(3) == taken, "set_id accepts the id a subnet already has");
+
+    SubnetStore plan;
+    plan.set_id(plan.create(Cidr{0xC0A80000u, 16}), 1);
+    store = std::move(plan);
+    const StoreStats& stats = store.get_stats();
+    failures += check(stats.created == 4, "created counts both stores");
+    failures += check(stats.released == 3, "released counts the replaced subnets");
+    failures += check(stats.chunks == 2, "chunks counts both arenas");
+    failures += check(store.size() == 1 && store.find(1) && store.find(1)->get_slash() == 16, "the moved plan is kept");
+    failures += check(plan.get_stats().created == 0 && plan.empty(), "the moved-from store is empty");
+
+    // Columns by slot: removing a subtree closes the gap and the handles follow
+    SubnetStore columns;
+    Network* root = columns.create(Cidr{0xC0A80000u, 24});
+    Network* low = columns.create(Cidr{0xC0A80000u, 25});
+    Network* high = columns.create(Cidr{0xC0A80080u, 25});
+    columns.set_id(root, 1);
+    columns.set_id(low, 2);
+    columns.set_id(high, 3);
+    columns.add_child(1, 2);
+    columns.add_child(1, 3);
+    high->set_name(Symbol("LAN B"));
+    columns.remove(low);
+    failures += check(columns.size() == 2 && columns.id_at(1) == 3 && columns[1] == high, "remove closes the gap");
+    failures += check(columns.core_at(1).address == 0xC0A80080u && columns.core_at(1).slash == 25,
+                      "the core moves with its subnet");
+    failures += check(columns.details_at(1).name == Symbol("LAN B") && !root->has_details(), "so do the details");
+    high->set_split(true);
+    failures += check(columns.core_at(1).flags & NETWORK_SPLIT, "setters write the column");
+
+    SubnetStore moved(std::move(columns));
+    high->set_slash(26);
+    failures += check(moved.core_at(1).slash == 26 && high->get_name() == Symbol("LAN B"),
+                      "handles read the store they were moved into");
+
+    std::printf("%d store checks failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+// A SubnetTable built from a range must hold the same rows as the range itself,
+// including a page that starts past the first subnet of the split.
+#include <subnet_table.hpp>
+#include <subnet_range.hpp>
+#include <cstdint>
+#include <cstdio>
+
+static int compare(const SubnetRange& range, const char* what)
+{
+    SubnetTable table(range);
+    if (table.size() != range.size())
+    {
+        std::printf("%s: %zu rows, expected %llu\n", what, table.size(), (unsigned long long)range.size());
+        return 1;
+    }
+    for (size_t i = 0; i < table.size(); i++)
+    {
+        Subnet expected = range[i];
+        if (table.get_address(i) != expected.address || table.get_broadcast(i) != expected.broadcast ||
+            table.get_slash(i) != expected.slash)
+        {
+            std::printf("%s: row %zu differs\n", what, i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main()
+{
+    int failures = 0;
+    SubnetRange split(0x0A000000u, 8, 16);    // 10.0.0.0/8 into /24s
+
+    failures += compare(split.page(0, 100), "first page");
+    failures += compare(split.page(1000, 37), "page at 1000");
+    failures += compare(split.page(65500, 0), "last page");
+    failures += compare(split.page(1000, 37).page(5, 10), "page of a page");
+
+    SubnetTable table(split.page(256, 1));
+    if (table.size() != 1 || table.get_address(0) != 0x0A010000u)
+    {
+        std::printf("page at 256 does not start at 10.1.0.0\n");
+        failures++;
+    }
+
+    std::printf("%d table checks failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -1,4 +1,5 @@
 #include <string>
+#include <cstdint>
 #include <spdlog/spdlog.h>
 
 class Arguments
@@ -8,6 +9,17 @@ private:
     std::string str_network;
     int required_hosts;
     int required_subnets;
+    std::string output_path;
+    int threads;
+    uint64_t offset;
+    uint64_t limit;
+    std::string find_address;
+    bool summary;
+    int exact_subnets;
+    bool equal_size;
+    size_t log_queue_size;
+    bool log_drop_when_full;
+    std::string output_format;
 
 public:
     Arguments();
@@ -16,11 +28,33 @@ public:
     std::string get_str_network();
     int get_required_hosts();
     int get_required_subnets();
+    std::string get_output_path();
+    int get_threads();
+    uint64_t get_offset();
+    uint64_t get_limit();
+    std::string get_find_address();
+    bool get_summary();
+    int get_exact_subnets();
+    bool get_equal_size();
+    size_t get_log_queue_size();
+    bool get_log_drop_when_full();
+    std::string get_output_format();
 
     void set_log_level(spdlog::level::level_enum log_level);
     void set_str_network(std::string network);
     void set_required_hosts(int required_hosts);
     void set_required_subnets(int required_subnets);
+    void set_output_path(std::string output_path);
+    void set_threads(int threads);
+    void set_offset(uint64_t offset);
+    void set_limit(uint64_t limit);
+    void set_find_address(std::string find_address);
+    void set_summary(bool summary);
+    void set_exact_subnets(int exact_subnets);
+    void set_equal_size(bool equal_size);
+    void set_log_queue_size(size_t log_queue_size);
+    void set_log_drop_when_full(bool log_drop_when_full);
+    void set_output_format(std::string output_format);
 };
 
 Arguments* parse_arguments(int argc, char** argv);
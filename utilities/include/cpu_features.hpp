@@ -0,0 +1,10 @@
+#ifndef CPU_FEATURES_HPP
+#define CPU_FEATURES_HPP
+
+// Runtime CPU feature detection (cpuid), used to pick SIMD code paths.
+// Always false on non-x86 builds, so callers fall back to scalar code.
+bool cpu_has_sse2();
+bool cpu_has_sse41();
+bool cpu_has_avx2();
+
+#endif
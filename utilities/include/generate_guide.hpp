@@ -5,8 +5,9 @@
 #include <string>
 #include "topology.hpp"
 #include "network.hpp"
+#include "subnet_store.hpp"
 
 // Prototypes for guide generation
-void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<Link*>& links, const std::vector<Network*>& subnets);
+void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<Link*>& links, const SubnetStore& subnets);
 
 #endif
@@ -2,6 +2,37 @@
 
 inline std::shared_ptr<spdlog::logger> logger;
 
+// Lowest level compiled in (0 trace ... 6 off). CMake raises it for Release builds
+// of the libraries; calls below it are dead code and disappear entirely.
+#ifndef LOG_ACTIVE_LEVEL
+#define LOG_ACTIVE_LEVEL 0
+#endif
 
-void activate_logging(spdlog::level::level_enum log_level);
-spdlog::level::level_enum str_tenum(std::string str_log_level);
\ No newline at end of file
+// Like logger->xxx(...), but the arguments are only evaluated when the level is enabled
+#define LOG_AT(level, ...) \
+    do { \
+        if ((int)(level) >= LOG_ACTIVE_LEVEL && logger->should_log(level)) \
+            logger->log(level, __VA_ARGS__); \
+    } while (0)
+
+#define LOG_TRACE(...) LOG_AT(spdlog::level::trace, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_AT(spdlog::level::debug, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(spdlog::level::info, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(spdlog::level::warn, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(spdlog::level::err, __VA_ARGS__)
+#define LOG_CRITICAL(...) LOG_AT(spdlog::level::critical, __VA_ARGS__)
+
+
+// With async_queue_size > 0 messages are formatted by the caller and written by a
+// background thread through a preallocated ring of that many entries. When it is full the
+// caller waits, or with drop_when_full the message is discarded and counted.
+// With to_stderr the console logger writes to stderr, leaving stdout to the results.
+void activate_logging(spdlog::level::level_enum log_level, size_t async_queue_size = 0, bool drop_when_full = false,
+                      bool to_stderr = false);
+// Flushes and releases the global logger; no LOG_* calls may follow
+void deactivate_logging();
+// Messages discarded by an async logger in drop mode, exact after deactivate_logging()
+size_t dropped_log_messages();
+// Messages an async logger cut to fit its slots (LOG_SLOT_SIZE bytes)
+size_t truncated_log_messages();
+spdlog::level::level_enum str_tenum(std::string str_log_level);
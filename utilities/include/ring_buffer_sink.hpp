@@ -0,0 +1,61 @@
+#ifndef RING_BUFFER_SINK_HPP
+#define RING_BUFFER_SINK_HPP
+
+#include <spdlog/sinks/sink.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define LOG_SLOT_SIZE 256   // bytes of one formatted message; longer ones are cut
+#define LOG_TRUNCATED_MARK " [truncated]\n"  // ends a line that was cut
+
+// Hands formatted messages to a background thread that writes them to `target`.
+// Every slot of the ring is allocated up front, so logging never allocates: the
+// caller copies its line into the next slot and returns. A line longer than a slot
+// is cut, ends with LOG_TRUNCATED_MARK and is counted. When the ring is full the
+// caller waits for a free slot, or with drop_when_full the message is discarded
+// and counted. Destroying the sink writes whatever is still queued.
+class RingBufferSink : public spdlog::sinks::sink
+{
+private:
+    struct Slot
+    {
+        spdlog::level::level_enum level;
+        uint16_t size;
+        uint16_t color_start;
+        uint16_t color_end;
+        char text[LOG_SLOT_SIZE];
+    };
+
+    spdlog::sink_ptr target;
+    bool drop_when_full;
+    std::vector<Slot> slots;
+    size_t head;                // next slot to write out
+    size_t count;               // slots waiting to be written
+    bool writing;               // the worker holds a message it took from the ring
+    bool stopping;
+    std::atomic<size_t> dropped;
+    std::atomic<size_t> truncated;
+    std::mutex lock;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::thread worker;
+
+    void write_loop();
+
+public:
+    RingBufferSink(spdlog::sink_ptr target, size_t capacity, bool drop_when_full);
+    ~RingBufferSink() override;
+
+    void log(const spdlog::details::log_msg& msg) override;
+    // Waits until every queued message was written, then flushes the target
+    void flush() override;
+
+    size_t get_dropped() const { return dropped.load(std::memory_order_relaxed); }
+    size_t get_truncated() const { return truncated.load(std::memory_order_relaxed); }
+};
+
+#endif
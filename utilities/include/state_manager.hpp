@@ -6,13 +6,13 @@
 #include <string>
 #include "topology.hpp"
 
-class Network;
+class SubnetStore;
 
 class StateManager {
 public:
-    static void save(const std::vector<Device*>& devices, const std::vector<Link*>& links, const std::vector<Network*>& subnets);
-    static void load(std::vector<Device*>& devices, std::vector<Link*>& links, std::vector<Network*>& subnets);
-    static bool load_scenario(const std::string& filename, std::vector<Device*>& devices, std::vector<Link*>& links, std::vector<Network*>& subnets);
+    static void save(const std::vector<Device*>& devices, const std::vector<Link*>& links, const SubnetStore& subnets);
+    static void load(std::vector<Device*>& devices, std::vector<Link*>& links, SubnetStore& subnets);
+    static bool load_scenario(const std::string& filename, std::vector<Device*>& devices, std::vector<Link*>& links, SubnetStore& subnets);
 };
 
 #endif
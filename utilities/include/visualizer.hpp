@@ -6,14 +6,15 @@
 #include <set>
 #include "topology.hpp"
 #include "network.hpp"
+#include "subnet_store.hpp"
 
 class Visualizer {
 public:
-    static void draw(const std::vector<Device*>& devices, const std::vector<Link*>& links, const std::vector<Network*>& subnets);
+    static void draw(const std::vector<Device*>& devices, const std::vector<Link*>& links, const SubnetStore& subnets);
 
 private:
     static void print_node(Device* dev, std::string prefix, bool is_last, std::set<std::string>& visited, 
-                           const std::vector<Link*>& links, const std::vector<Network*>& subnets);
+                           const std::vector<Link*>& links, const SubnetStore& subnets);
 };
 
 #endif
@@ -2,6 +2,8 @@
 #include <argparse.hpp>
 #include <logging.hpp>
 #include <iostream>
+#include <algorithm>
+#include <thread>
 
 
 // Arguments class definitions
@@ -28,6 +30,61 @@ int Arguments::get_required_subnets()
     return this->required_subnets;
 }
 
+std::string Arguments::get_output_path()
+{
+    return this->output_path;
+}
+
+int Arguments::get_threads()
+{
+    return this->threads;
+}
+
+uint64_t Arguments::get_offset()
+{
+    return this->offset;
+}
+
+uint64_t Arguments::get_limit()
+{
+    return this->limit;
+}
+
+std::string Arguments::get_find_address()
+{
+    return this->find_address;
+}
+
+bool Arguments::get_summary()
+{
+    return this->summary;
+}
+
+int Arguments::get_exact_subnets()
+{
+    return this->exact_subnets;
+}
+
+bool Arguments::get_equal_size()
+{
+    return this->equal_size;
+}
+
+size_t Arguments::get_log_queue_size()
+{
+    return this->log_queue_size;
+}
+
+bool Arguments::get_log_drop_when_full()
+{
+    return this->log_drop_when_full;
+}
+
+std::string Arguments::get_output_format()
+{
+    return this->output_format;
+}
+
 
 void Arguments::set_log_level(spdlog::level::level_enum log_level)
 {
@@ -49,6 +106,61 @@ void Arguments::set_required_subnets(int required_subnets)
     this->required_subnets = required_subnets;
 }
 
+void Arguments::set_output_path(std::string output_path)
+{
+    this->output_path = output_path;
+}
+
+void Arguments::set_threads(int threads)
+{
+    this->threads = threads;
+}
+
+void Arguments::set_offset(uint64_t offset)
+{
+    this->offset = offset;
+}
+
+void Arguments::set_limit(uint64_t limit)
+{
+    this->limit = limit;
+}
+
+void Arguments::set_find_address(std::string find_address)
+{
+    this->find_address = find_address;
+}
+
+void Arguments::set_summary(bool summary)
+{
+    this->summary = summary;
+}
+
+void Arguments::set_exact_subnets(int exact_subnets)
+{
+    this->exact_subnets = exact_subnets;
+}
+
+void Arguments::set_equal_size(bool equal_size)
+{
+    this->equal_size = equal_size;
+}
+
+void Arguments::set_log_queue_size(size_t log_queue_size)
+{
+    this->log_queue_size = log_queue_size;
+}
+
+void Arguments::set_log_drop_when_full(bool log_drop_when_full)
+{
+    this->log_drop_when_full = log_drop_when_full;
+}
+
+void Arguments::set_output_format(std::string output_format)
+{
+    this->output_format = output_format;
+}
+
 
 // Other functions definitions
 
@@ -60,6 +172,15 @@ Arguments* parse_arguments(int argc, char** argv)
         .help("Log level (trace, debug, info, error, critical), default is --level info")
         .default_value(std::string("info"));
 
+    program.add_argument("--async-log")
+        .help("Write logs from a background thread through a queue of this many messages, default is synchronous")
+        .default_value(0)
+        .action([] (const std::string& value) { return std::stoi(value); });
+
+    program.add_argument("--log-overflow")
+        .help("What --async-log does when its queue is full (block, drop), default is --log-overflow block")
+        .default_value(std::string("block"));
+
     program.add_argument("--hosts")
         .help("Required hosts to implement the subnetting")
         .default_value(0)
@@ -70,9 +191,51 @@ Arguments* parse_arguments(int argc, char** argv)
         .default_value(0)
         .action([] (const std::string& value) { return std::stoi(value); });
 
+    program.add_argument("-o", "--output")
+        .help("Write the subnetting results to a file instead of the console")
+        .default_value(std::string(""));
+
+    program.add_argument("-f", "--format")
+        .help("How the subnets are written (table, csv, ndjson, binary), logs go to stderr unless it is table")
+        .default_value(std::string("table"));
+
+    program.add_argument("-j", "--threads")
+        .help("Worker threads used to generate and print large results, default is one per core")
+        .default_value(0)
+        .action([] (const std::string& value) { return std::stoi(value); });
+
+    program.add_argument("--offset")
+        .help("First subnet ID to print")
+        .default_value(0ULL)
+        .action([] (const std::string& value) { return std::stoull(value); });
+
+    program.add_argument("--limit")
+        .help("Maximum number of subnets to print, default is all of them")
+        .default_value(0ULL)
+        .action([] (const std::string& value) { return std::stoull(value); });
+
+    program.add_argument("--find")
+        .help("Only print the subnet that contains this address")
+        .default_value(std::string(""));
+
+    program.add_argument("--exact")
+        .help("Split into exactly this many subnets, mixing prefixes so nothing is wasted")
+        .default_value(0)
+        .action([] (const std::string& value) { return std::stoi(value); });
+
+    program.add_argument("--equal")
+        .help("With --exact, give every subnet the same prefix and list the unused blocks")
+        .default_value(false)
+        .implicit_value(true);
+
+    program.add_argument("-s", "--summary")
+        .help("Only print the totals, first and last subnet, without listing every subnet")
+        .default_value(false)
+        .implicit_value(true);
+
     program.add_argument("network")
         .required()
-        .help("network segment, for example 192.168.1.1/24 ");
+        .help("network segment, for example 192.168.1.1/24, \"192.168.1.1 255.255.255.0\" or 192.168.1.0-192.168.1.255 ");
 
     try
     {
@@ -90,12 +253,51 @@ Arguments* parse_arguments(int argc, char** argv)
     std::string str_network = program.get<std::string>("network");
     int hosts = program.get<int>("--hosts");
     int subnets = program.get<int>("--subnets");
+    std::string output_path = program.get<std::string>("--output");
+    int threads = program.get<int>("--threads");
+    uint64_t offset = program.get<unsigned long long>("--offset");
+    uint64_t limit = program.get<unsigned long long>("--limit");
+    std::string find_address = program.get<std::string>("--find");
+    bool summary = program.get<bool>("--summary");
+    int exact_subnets = program.get<int>("--exact");
+    bool equal_size = program.get<bool>("--equal");
+    int log_queue_size = program.get<int>("--async-log");
+    std::string log_overflow = program.get<std::string>("--log-overflow");
+    if (log_overflow != "block" && log_overflow != "drop")
+    {
+        std::cout << "Unknown --log-overflow policy [" << log_overflow << "], expected block or drop" << std::endl;
+        exit(1);
+    }
+    std::string output_format = program.get<std::string>("--format");
+    if (output_format != "table" && output_format != "csv" && output_format != "ndjson" && output_format != "binary")
+    {
+        std::cout << "Unknown --format [" << output_format << "], expected table, csv, ndjson or binary" << std::endl;
+        exit(1);
+    }
+    if (summary && output_format == "binary")
+    {
+        std::cout << "--summary has no binary format, use table, csv or ndjson" << std::endl;
+        exit(1);
+    }
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
 
     Arguments* arguments = new Arguments();
     arguments->set_str_network(str_network);
     arguments->set_log_level(str_tenum(log_level));
     arguments->set_required_hosts(hosts);
     arguments->set_required_subnets(subnets);
+    arguments->set_output_path(output_path);
+    arguments->set_threads(threads);
+    arguments->set_offset(offset);
+    arguments->set_limit(limit);
+    arguments->set_find_address(find_address);
+    arguments->set_summary(summary);
+    arguments->set_exact_subnets(exact_subnets);
+    arguments->set_equal_size(equal_size);
+    arguments->set_log_queue_size(std::max(0, log_queue_size));
+    arguments->set_log_drop_when_full(log_overflow == "drop");
+    arguments->set_output_format(output_format);
 
     return arguments;
 }
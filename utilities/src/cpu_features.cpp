@@ -0,0 +1,35 @@
+#include "cpu_features.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_X86 1
+#endif
+
+bool cpu_has_sse2()
+{
+#ifdef CPU_X86
+    static const bool supported = __builtin_cpu_supports("sse2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_sse41()
+{
+#ifdef CPU_X86
+    static const bool supported = __builtin_cpu_supports("sse4.1");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_avx2()
+{
+#ifdef CPU_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
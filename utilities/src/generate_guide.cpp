@@ -1,4 +1,6 @@
 #include "generate_guide.hpp"
+#include "netparser.hpp"
+#include "prefix.hpp"
 #include <iostream>
 #include <algorithm>
 #include <map>
@@ -21,7 +23,7 @@
  * Helper: Detect if the router connected to a switch is configured for VLANs (ROAS).
  * This determines if the switch uplink port Gig0/1 should be TRUNK or ACCESS.
  */
-std::string get_uplink_mode_from_router(Device* sw_device, const std::vector<Link*>& links, const std::vector<Network*>& subnets) {
+std::string get_uplink_mode_from_router(Device* sw_device, const std::vector<Link*>& links, const SubnetStore& subnets) {
     // 1. Find the device connected to Gig0/1
     Device* router_dev = nullptr;
     for (auto l : links) {
@@ -49,12 +51,14 @@ std::string get_uplink_mode_from_router(Device* sw_device, const std::vector<Lin
 
     // 3. If connected to a router, check its assigned subnets for VLAN involvement
     if (router_dev && router_dev->get_type() == DeviceType::ROUTER) {
-        for (auto n : subnets) {
-            if (n->is_split) continue;
+        for (size_t i = 0; i < subnets.size(); i++) {
+            const NetworkCore& core = subnets.core_at(i);
+            const NetworkDetails& details = subnets.details_at(i);
+            if (core.flags & NETWORK_SPLIT) continue;
             // Check if this subnet is assigned to the connected router
-            if (n->get_assignment().find(router_dev->get_hostname()) != std::string::npos) {
+            if (details.assignment_tag.str().find(router_dev->get_hostname()) != std::string::npos) {
                 // If ANY assigned subnet has a VLAN ID > 1, the router needs TRUNK
-                if (n->associated_vlan_id > 1) {
+                if (details.associated_vlan_id > 1) {
                     return "TRUNK";
                 }
             }
@@ -76,7 +80,7 @@ std::string get_uplink_mode_from_router(Device* sw_device, const std::vector<Lin
     return "ACCESS";
 }
 
-void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<Link*>& links, const std::vector<Network*>& subnets) {
+void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<Link*>& links, const SubnetStore& subnets) {
     std::cout << "\n" << MAGENTA << "================ EXAM GUIDE ================" << RESET << "\n";
     
     // SECTION 1: Physical Connections
@@ -108,7 +112,7 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
                 if (VlanManager::vlan_exists(iface.vlan_id)) {
                     used_vlans[iface.vlan_id] = VlanManager::get_vlan_name(iface.vlan_id);
                 } else {
-                    used_vlans[iface.vlan_id] = iface.vlan_name.empty() ? "VLAN" + std::to_string(iface.vlan_id) : iface.vlan_name;
+                    used_vlans[iface.vlan_id] = iface.vlan_name.empty() ? "VLAN" + std::to_string(iface.vlan_id) : iface.vlan_name.str();
                 }
             }
         }
@@ -242,11 +246,12 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
         std::cout << YELLOW << "hostname " << WHITE << r->get_hostname() << RESET << "\n";
         std::cout << YELLOW << "enable secret " << WHITE << "class" << RESET << "\n";
         
-        std::vector<Network*> router_subnets;
-        for (auto n : subnets) {
-            if (n->is_split) continue;
-            if (n->get_assignment().find(r->get_hostname()) != std::string::npos) {
-                router_subnets.push_back(n);
+        // Slots of the subnets assigned to this router
+        std::vector<size_t> router_subnets;
+        for (size_t i = 0; i < subnets.size(); i++) {
+            if (subnets.core_at(i).flags & NETWORK_SPLIT) continue;
+            if (subnets.details_at(i).assignment_tag.str().find(r->get_hostname()) != std::string::npos) {
+                router_subnets.push_back(i);
             }
         }
         
@@ -262,9 +267,11 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
         std::set<std::string> base_interfaces_used;
         
         // PASS 0: WAN Peers
-        for (auto n : subnets) {
-            if (n->is_split || n->get_slash() != 30) continue;
-            std::string assignment = n->get_assignment();
+        for (size_t i = 0; i < subnets.size(); i++) {
+            const NetworkCore& core = subnets.core_at(i);
+            const NetworkDetails& details = subnets.details_at(i);
+            if ((core.flags & NETWORK_SPLIT) || core.slash != 30) continue;
+            std::string assignment = details.assignment_tag.str();
             if (assignment.find(r->get_hostname()) != std::string::npos) continue;
             
             for (auto link : links) {
@@ -273,8 +280,8 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
                 
                 if (other_device && other_device->get_type() == DeviceType::ROUTER) {
                     if (assignment.find(other_device->get_hostname()) != std::string::npos) {
-                        std::string peer_ip = address_to_str(n->get_address() + 2);
-                        std::string mask_str = address_to_str(n->get_mask());
+                        std::string peer_ip = address_to_str(core.address + 2);
+                        std::string mask_str = address_to_str(core.mask);
                         std::cout << CYAN << "!\n! WAN Peer Interface (Link to " << other_device->get_hostname() << ")" << RESET << "\n";
                         std::cout << YELLOW << " interface " << BLUE << my_port << RESET << "\n";
                         
@@ -293,8 +300,8 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
                             my_ip = my_iface->manual_ip;
                         } else {
                             // Fallback Smart Default
-                            if (r->get_hostname() == "Router1") my_ip = address_to_str(n->get_address() + 2);
-                            else my_ip = address_to_str(n->get_address() + 1);
+                            if (r->get_hostname() == "Router1") my_ip = address_to_str(core.address + 2);
+                            else my_ip = address_to_str(core.address + 1);
                         }
                         
                         std::cout << YELLOW << " ip address " << WHITE << my_ip << " " << mask_str << RESET << "\n";
@@ -312,37 +319,39 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
         }
         
         // PASS 1: Interfaces
-        for (auto n : router_subnets) {
-            std::string iface_name = n->get_assigned_interface();
-            int vlan_id = n->associated_vlan_id;
-            int cidr = n->get_slash();
-            std::string mask_str = address_to_str(n->get_mask());
+        for (size_t i : router_subnets) {
+            const NetworkCore& core = subnets.core_at(i);
+            const NetworkDetails& details = subnets.details_at(i);
+            std::string iface_name = details.assigned_interface.str();
+            int vlan_id = details.associated_vlan_id;
+            int cidr = core.slash;
+            std::string mask_str = address_to_str(core.mask);
             // Gateway IP Logic (Smart Defaults & Manual Override)
             std::string gateway_str;
-            if (!n->gateway_manual_ip.empty()) {
-                gateway_str = n->gateway_manual_ip;
+            if (!details.gateway_manual_ip.empty()) {
+                gateway_str = details.gateway_manual_ip;
             } else {
                 // Smart Defaults
                 if (cidr == 30) {
                      // WAN Link
                      if (r->get_hostname() == "Router1") {
                          // Router1 gets the second/last usable IP on WAN
-                         gateway_str = address_to_str(n->get_address() + 2);
+                         gateway_str = address_to_str(core.address + 2);
                      } else {
                          // Router0 or others get the first usable
-                         gateway_str = address_to_str(n->get_address() + 1);
+                         gateway_str = address_to_str(core.address + 1);
                      }
                 } else {
                     // Standard LAN Gateway: First Usable
-                    gateway_str = address_to_str(n->get_address() + 1);
+                    gateway_str = address_to_str(core.address + 1);
                 }
             }
             
             std::string dhcp_mode_tag = "";
             if (cidr >= 30) dhcp_mode_tag = std::string(CYAN) + "! DHCP Mode: None (WAN Link)" + RESET;
-            else if (!n->dhcp_enabled) dhcp_mode_tag = std::string(CYAN) + "! DHCP Mode: None (Static)" + RESET;
-            else if (!n->dhcp_helper_ip.empty()) dhcp_mode_tag = std::string(CYAN) + "! DHCP Mode: Relay -> " + YELLOW + n->dhcp_helper_ip + RESET;
-            else dhcp_mode_tag = n->dhcp_upper_half_only ? std::string(CYAN) + "! DHCP Mode: Server (Highest Half Exclusion)" + RESET : std::string(CYAN) + "! DHCP Mode: Server (Standard)" + RESET;
+            else if (!details.dhcp_enabled) dhcp_mode_tag = std::string(CYAN) + "! DHCP Mode: None (Static)" + RESET;
+            else if (!details.dhcp_helper_ip.empty()) dhcp_mode_tag = std::string(CYAN) + "! DHCP Mode: Relay -> " + YELLOW + details.dhcp_helper_ip + RESET;
+            else dhcp_mode_tag = details.dhcp_upper_half_only ? std::string(CYAN) + "! DHCP Mode: Server (Highest Half Exclusion)" + RESET : std::string(CYAN) + "! DHCP Mode: Server (Standard)" + RESET;
 
             if (vlan_id > 1) {
                 std::string base_iface = iface_name;
@@ -354,7 +363,7 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
                 std::cout << YELLOW << "interface " << BLUE << iface_name << RESET << "\n";
                 std::cout << YELLOW << " encapsulation dot1q " << WHITE << vlan_id << RESET << "\n";
                 std::cout << YELLOW << " ip address " << WHITE << gateway_str << " " << mask_str << RESET << "\n";
-                if (n->dhcp_enabled && !n->dhcp_helper_ip.empty()) std::cout << YELLOW << " ip helper-address " << MAGENTA << n->dhcp_helper_ip << RESET << "\n";
+                if (details.dhcp_enabled && !details.dhcp_helper_ip.empty()) std::cout << YELLOW << " ip helper-address " << MAGENTA << details.dhcp_helper_ip << RESET << "\n";
                 std::cout << GREEN << " no shutdown" << RESET << "\n exit\n";
             } else {
                 std::cout << CYAN << "!" << RESET << "\n";
@@ -362,7 +371,7 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
                 else std::cout << CYAN << "! Physical LAN Interface" << RESET << "\n" << dhcp_mode_tag << "\n";
                 std::cout << YELLOW << " interface " << BLUE << iface_name << RESET << "\n";
                 std::cout << YELLOW << " ip address " << WHITE << gateway_str << " " << mask_str << RESET << "\n";
-                if (n->dhcp_enabled && !n->dhcp_helper_ip.empty()) std::cout << YELLOW << " ip helper-address " << MAGENTA << n->dhcp_helper_ip << RESET << "\n";
+                if (details.dhcp_enabled && !details.dhcp_helper_ip.empty()) std::cout << YELLOW << " ip helper-address " << MAGENTA << details.dhcp_helper_ip << RESET << "\n";
                 
                 // Clock Rate logic for DCE (Router0)
                 if ((iface_name.find("Se") == 0 || iface_name.find("se") == 0) && (this_router_idx == 0 || r->get_hostname() == "Router0")) {
@@ -393,39 +402,40 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
         struct DHCPPool { std::string name; std::string network; std::string mask; std::string gateway; bool upper_half_only; };
         std::vector<DHCPPool> dhcp_pools;
 
-        for (auto n : subnets) {
-            if (n->is_split) continue;
+        for (size_t i = 0; i < subnets.size(); i++) {
+            const NetworkCore& core = subnets.core_at(i);
+            const NetworkDetails& details = subnets.details_at(i);
+            if (core.flags & NETWORK_SPLIT) continue;
             
             bool should_generate = false;
-            if (n->dhcp_enabled) {
-                if (n->dhcp_server_id != -1) {
+            if (details.dhcp_enabled) {
+                if (details.dhcp_server_id != -1) {
                     // Check absolute device ID (harmonized with main.cpp)
-                    if (n->dhcp_server_id == this_router_idx) {
+                    if (details.dhcp_server_id == this_router_idx) {
                         should_generate = true;
                     }
                 } else {
                     // ID is -1. Check if implicit local (No helper IP + Assigned to this router)
-                    if (n->dhcp_helper_ip.empty() && n->get_assignment().find(r->get_hostname()) != std::string::npos) {
+                    if (details.dhcp_helper_ip.empty() && details.assignment_tag.str().find(r->get_hostname()) != std::string::npos) {
                         should_generate = true;
                     }
                 }
             }
             
             if (should_generate) {
-                std::string pool_name = !n->name.empty() ? "POOL_" + n->name : (n->associated_vlan_id > 1 ? "POOL_VLAN" + std::to_string(n->associated_vlan_id) : "POOL_LAN");
+                std::string pool_name = !details.name.empty() ? "POOL_" + details.name.str() : (details.associated_vlan_id > 1 ? "POOL_VLAN" + std::to_string(details.associated_vlan_id) : "POOL_LAN");
                 std::replace(pool_name.begin(), pool_name.end(), ' ', '_');
-                dhcp_pools.push_back({pool_name, address_to_str(n->get_address()), address_to_str(n->get_mask()), address_to_str(n->get_address() + 1), n->dhcp_upper_half_only});
+                dhcp_pools.push_back({pool_name, address_to_str(core.address), address_to_str(core.mask), address_to_str(core.address + 1), details.dhcp_upper_half_only});
             }
         }
         
         if (!dhcp_pools.empty()) {
             std::cout << CYAN << "!\n! --- DHCP Configuration ---" << RESET << "\n";
             for (const auto& pool : dhcp_pools) {
-                unsigned int mask_int = str_to_address(pool.mask);
-                int cidr = 0; while((mask_int << cidr) & 0x80000000) cidr++; 
+                int cidr = mask_to_prefix(str_to_address(pool.mask)); // pool masks come from prefix_mask
                 
                 unsigned int net_int = str_to_address(pool.network);
-                unsigned int total = (1U << (32 - cidr)); // Total size of subnet
+                unsigned int total = prefix_block_size(cidr); // Total size of subnet
                 
                 unsigned int ex_start = net_int + 1; // Start excluding from first usable
                 unsigned int ex_end = ex_start + 10; // Default: first 10
@@ -464,26 +474,28 @@ void menu_generate_guide(const std::vector<Device*>& devices, const std::vector<
         // This is strictly "Documentation/Guide" output, usually specific to the devices themselves, 
         // but user asked for "Plan" output. We'll append it here.
         
-        for (auto n : subnets) {
-             if (n->is_split || n->get_slash() >= 30) continue;
-             if (!n->dhcp_enabled && n->get_assignment().find(r->get_hostname()) != std::string::npos) {
+        for (size_t i = 0; i < subnets.size(); i++) {
+             const NetworkCore& core = subnets.core_at(i);
+             const NetworkDetails& details = subnets.details_at(i);
+             if ((core.flags & NETWORK_SPLIT) || core.slash >= 30) continue;
+             if (!details.dhcp_enabled && details.assignment_tag.str().find(r->get_hostname()) != std::string::npos) {
                  // Static Subnet (e.g. LAN C)
-                 std::cout << CYAN << "!\n! --- Static Device Plan for " << n->name << " ---" << RESET << "\n";
+                 std::cout << CYAN << "!\n! --- Static Device Plan for " << details.name << " ---" << RESET << "\n";
                  
                  // PC (Network + 2)
-                 std::string pc_ip = address_to_str(n->get_address() + 2);
-                 std::cout << CYAN << "! PC " << n->name << ": " << WHITE << pc_ip << " " << address_to_str(n->get_mask()) << " GW: " << address_to_str(n->get_address() + 1) << RESET << "\n";
+                 std::string pc_ip = address_to_str(core.address + 2);
+                 std::cout << CYAN << "! PC " << details.name << ": " << WHITE << pc_ip << " " << address_to_str(core.mask) << " GW: " << address_to_str(core.address + 1) << RESET << "\n";
                  
                  // Laptop (Network + 3)
-                 std::string laptop_ip = address_to_str(n->get_address() + 3);
-                 std::cout << CYAN << "! Laptop " << n->name << ": " << WHITE << laptop_ip << " " << address_to_str(n->get_mask()) << " GW: " << address_to_str(n->get_address() + 1) << RESET << "\n";
+                 std::string laptop_ip = address_to_str(core.address + 3);
+                 std::cout << CYAN << "! Laptop " << details.name << ": " << WHITE << laptop_ip << " " << address_to_str(core.mask) << " GW: " << address_to_str(core.address + 1) << RESET << "\n";
                  
                  // Switch (Last Usable)
-                 unsigned int net_int = n->get_address();
-                 int cidr = n->get_slash();
-                 unsigned int broadcast = net_int | ((1U << (32 - cidr)) - 1);
+                 unsigned int net_int = core.address;
+                 int cidr = core.slash;
+                 unsigned int broadcast = net_int | prefix_wildcard(cidr);
                  std::string switch_ip = address_to_str(broadcast - 1);
-                 std::cout << CYAN << "! Switch " << n->name << ": " << WHITE << switch_ip << " " << address_to_str(n->get_mask()) << " GW: " << address_to_str(n->get_address() + 1) << RESET << "\n";
+                 std::cout << CYAN << "! Switch " << details.name << ": " << WHITE << switch_ip << " " << address_to_str(core.mask) << " GW: " << address_to_str(core.address + 1) << RESET << "\n";
              }
         }
         
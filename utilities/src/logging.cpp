@@ -1,4 +1,5 @@
 #include <logging.hpp>
+#include <ring_buffer_sink.hpp>
 #define TRACE "trace"
 #define DEBUG "debug"
 #define INFO "info"
@@ -7,13 +8,49 @@
 #define CRITICAL "critical"
 
 
-void activate_logging(spdlog::level::level_enum log_level)
+// Queue of the async console logger; kept so its drops can still be read after shutdown
+static std::shared_ptr<RingBufferSink> log_ring;
+static size_t final_dropped = 0;
+static size_t final_truncated = 0;
+
+void activate_logging(spdlog::level::level_enum log_level, size_t async_queue_size, bool drop_when_full, bool to_stderr)
 {
     // create color multi threaded logger
-    logger = spdlog::stdout_color_mt("console");
+    logger = to_stderr ? spdlog::stderr_color_mt("console") : spdlog::stdout_color_mt("console");
+    if (async_queue_size > 0)
+    {
+        // Same color sink, written from the background thread of the ring
+        log_ring = std::make_shared<RingBufferSink>(logger->sinks().front(), async_queue_size, drop_when_full);
+        spdlog::drop("console");
+        logger = std::make_shared<spdlog::logger>("console", log_ring);
+        spdlog::register_logger(logger);
+    }
     logger->set_pattern("[%d-%b-%Y %T] [%l] %v");
     logger->set_level(log_level);
-    logger->trace("Global logger activated");
+    LOG_TRACE("Global logger activated{}", log_ring ? " (async)" : "");
+}
+
+void deactivate_logging()
+{
+    spdlog::drop_all();
+    logger.reset();
+    if (log_ring)
+    {
+        // The last reference to the ring writes out what is still queued
+        final_dropped = log_ring->get_dropped();
+        final_truncated = log_ring->get_truncated();
+        log_ring.reset();
+    }
+}
+
+size_t dropped_log_messages()
+{
+    return log_ring ? log_ring->get_dropped() : final_dropped;
+}
+
+size_t truncated_log_messages()
+{
+    return log_ring ? log_ring->get_truncated() : final_truncated;
 }
 
 spdlog::level::level_enum str_tenum(std::string str_log_level)
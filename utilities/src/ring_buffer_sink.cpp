@@ -0,0 +1,107 @@
+#include <ring_buffer_sink.hpp>
+#include <spdlog/details/log_msg.h>
+#include <algorithm>
+
+RingBufferSink::RingBufferSink(spdlog::sink_ptr target, size_t capacity, bool drop_when_full)
+    : slots(std::max<size_t>(capacity, 1))
+{
+    this->target = std::move(target);
+    this->drop_when_full = drop_when_full;
+    this->head = 0;
+    this->count = 0;
+    this->writing = false;
+    this->stopping = false;
+    this->dropped = 0;
+    this->truncated = 0;
+    worker = std::thread(&RingBufferSink::write_loop, this);
+}
+
+RingBufferSink::~RingBufferSink()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    not_empty.notify_one();
+    worker.join();
+}
+
+void RingBufferSink::log(const spdlog::details::log_msg& msg)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    if (count == slots.size())
+    {
+        if (drop_when_full)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        not_full.wait(guard, [this] { return count < slots.size(); });
+    }
+
+    // A line that does not fit is cut and ends with the marker instead
+    Slot& slot = slots[(head + count) % slots.size()];
+    size_t size = msg.formatted.size();
+    if (size <= LOG_SLOT_SIZE)
+    {
+        std::copy(msg.formatted.data(), msg.formatted.data() + size, slot.text);
+    }
+    else
+    {
+        size_t kept = LOG_SLOT_SIZE - (sizeof(LOG_TRUNCATED_MARK) - 1);
+        std::copy(msg.formatted.data(), msg.formatted.data() + kept, slot.text);
+        std::copy(LOG_TRUNCATED_MARK, LOG_TRUNCATED_MARK + sizeof(LOG_TRUNCATED_MARK) - 1, slot.text + kept);
+        size = LOG_SLOT_SIZE;
+        truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot.level = msg.level;
+    slot.size = (uint16_t)size;
+    slot.color_start = (uint16_t)std::min(msg.color_range_start, size);
+    slot.color_end = (uint16_t)std::min(msg.color_range_end, size);
+    count++;
+    guard.unlock();
+    not_empty.notify_one();
+}
+
+void RingBufferSink::flush()
+{
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        not_full.wait(guard, [this] { return count == 0 && !writing; });
+    }
+    target->flush();
+}
+
+void RingBufferSink::write_loop()
+{
+    // One message reused for every line; its inline buffer holds a whole slot
+    spdlog::details::log_msg msg;
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+        not_empty.wait(guard, [this] { return count > 0 || stopping; });
+        if (count == 0)
+            break;
+
+        const Slot& slot = slots[head];
+        msg.formatted.clear();
+        msg.formatted.buffer().append(slot.text, slot.text + slot.size);
+        msg.level = slot.level;
+        msg.color_range_start = slot.color_start;
+        msg.color_range_end = slot.color_end;
+        head = (head + 1) % slots.size();
+        count--;
+        writing = true;
+        guard.unlock();
+        not_full.notify_all();
+
+        target->log(msg);
+
+        guard.lock();
+        writing = false;
+        if (count == 0)
+            not_full.notify_all();
+    }
+    guard.unlock();
+    target->flush();
+}
@@ -2,9 +2,10 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
-#include <map>
 #include "vlan_manager.hpp"
 #include "network.hpp"
+#include "subnet_store.hpp"
+#include "prefix.hpp"
 
 // Helpers
 static void trim(std::string &s) {
@@ -21,7 +22,7 @@ static void trim(std::string &s) {
     s.erase(end.base(), s.end());
 }
 
-void StateManager::save(const std::vector<Device*>& devices, const std::vector<Link*>& links, const std::vector<Network*>& subnets) {
+void StateManager::save(const std::vector<Device*>& devices, const std::vector<Link*>& links, const SubnetStore& subnets) {
     std::ofstream file("network_save.dat");
     if (!file.is_open()) {
         std::cout << "Error: Could not open file for writing.\n";
@@ -59,20 +60,24 @@ void StateManager::save(const std::vector<Device*>& devices, const std::vector<L
     }
 
     // [SUBNETS]
-    // # ID | Network | Slash | ParentID | Name | AssignedString | AssignedInterface | VlanID | DHCPEnabled | DHCPUpperHalf | DHCPServerID | DHCPHelperIP
+    // # ID | Network | Slash | ParentID | Name | AssignedString | AssignedInterface | VlanID | DHCPEnabled | DHCPUpperHalf | DHCPServerID | DHCPHelperIP | GatewayIP | Spare
     file << "\n[SUBNETS]\n";
-    for(auto n : subnets) {
-        std::string helper_ip = n->dhcp_helper_ip.empty() ? "NONE" : n->dhcp_helper_ip;
-        file << n->id << "|" << address_to_str(n->get_address()) << "|" 
-             << n->get_slash() << "|" << n->parent_id << "|"
-             << (n->name.empty() ? "" : n->name) << "|"
-             << n->get_assignment() << "|" << n->get_assigned_interface() 
-             << "|" << n->associated_vlan_id
-             << "|" << (n->dhcp_enabled ? 1 : 0)
-             << "|" << (n->dhcp_upper_half_only ? 1 : 0)
-             << "|" << n->dhcp_server_id
+    for (size_t i = 0; i < subnets.size(); i++) {
+        const NetworkCore& core = subnets.core_at(i);
+        const NetworkDetails& details = subnets.details_at(i);
+        int id = subnets.id_at(i);
+        std::string helper_ip = details.dhcp_helper_ip.empty() ? "NONE" : details.dhcp_helper_ip;
+        file << id << "|" << address_to_str(core.address) << "|" 
+             << (int)core.slash << "|" << subnets.get_parent(id) << "|"
+             << details.name << "|"
+             << details.assignment_tag << "|" << details.assigned_interface 
+             << "|" << details.associated_vlan_id
+             << "|" << (details.dhcp_enabled ? 1 : 0)
+             << "|" << (details.dhcp_upper_half_only ? 1 : 0)
+             << "|" << details.dhcp_server_id
              << "|" << helper_ip 
-             << "|" << n->gateway_manual_ip << "\n";
+             << "|" << details.gateway_manual_ip
+             << "|" << ((core.flags & NETWORK_SPARE) ? 1 : 0) << "\n";
     }
 
     // [DEVICE_CONFIGS]
@@ -143,13 +148,12 @@ void StateManager::save(const std::vector<Device*>& devices, const std::vector<L
     std::cout << "State saved to network_save.dat.\n";
 }
 
-void StateManager::load(std::vector<Device*>& devices, std::vector<Link*>& links, std::vector<Network*>& subnets) {
+void StateManager::load(std::vector<Device*>& devices, std::vector<Link*>& links, SubnetStore& subnets) {
     // Clear existing
     for(auto d : devices) delete d;
     devices.clear();
     for(auto l : links) delete l;
     links.clear();
-    for(auto n : subnets) delete n;
     subnets.clear();
     VlanManager::defined_vlans.clear();
     VlanManager::init(); // Reset to default 1
@@ -161,6 +165,7 @@ void StateManager::load(std::vector<Device*>& devices, std::vector<Link*>& links
     
     std::string line;
     std::string current_section;
+    std::vector<std::pair<int, int>> subnet_parents; // (ID, ParentID), linked once all subnets are read
 
     static_routes.clear();
 
@@ -222,43 +227,58 @@ void StateManager::load(std::vector<Device*>& devices, std::vector<Link*>& links
             }
         }
         else if (current_section == "[SUBNETS]") {
-            // ID|Net|Slash|Parent|Name|Assigned|Interface|VlanID|DHCPEnabled|DHCPUpperHalf|DHCPServerID|DHCPHelperIP
+            // ID|Net|Slash|Parent|Name|Assigned|Interface|VlanID|DHCPEnabled|DHCPUpperHalf|DHCPServerID|DHCPHelperIP|GatewayIP|Spare
             if (parts.size() >= 7) {
-                Network* n = new Network();
-                n->id = std::stoi(parts[0]);
-                int segments[4];
-                sscanf(parts[1].c_str(), "%d.%d.%d.%d", &segments[0], &segments[1], &segments[2], &segments[3]);
-                unsigned int net_int = (segments[0] << 24) | (segments[1] << 16) | (segments[2] << 8) | segments[3];
-                n->set_address(net_int);
+                int slash = std::stoi(parts[2]);
+                if (slash < 0 || slash > IPV4_NET_BITS) {
+                    std::cerr << "[WARNING] Skipping subnet " << parts[0] << ": invalid prefix /" << slash << "\n";
+                    continue;
+                }
+                if (subnets.find(std::stoi(parts[0]))) {
+                    std::cerr << "[WARNING] Skipping subnet " << parts[0] << ": the id is used twice\n";
+                    continue;
+                }
+                Network* n = subnets.create();
+                subnets.set_id(n, std::stoi(parts[0]));
+                n->set_address(str_to_address(parts[1]));
                 
-                n->set_slash(std::stoi(parts[2]));
-                unsigned int mask = (n->get_slash() == 0) ? 0 : (~0u) << (32 - n->get_slash());
+                n->set_slash(slash);
+                unsigned int mask = prefix_mask(n->get_slash());
                 n->set_mask(mask);
                 
-                n->parent_id = std::stoi(parts[3]);
-                n->name = parts[4];
-                n->set_assignment(parts[5]);
-                n->set_assigned_interface(parts[6]);
+                subnet_parents.push_back({n->id, std::stoi(parts[3])});
+                // Only fields that differ from the defaults are set, so a bare block
+                // loads without allocating its details
+                if (!parts[4].empty()) n->set_name(parts[4]);
+                if (Symbol(parts[5]) != SYMBOL_FREE) n->set_assignment(parts[5]);
+                if (!parts[6].empty()) n->set_assigned_interface(parts[6]);
                 
                 // Load associated VLAN ID if present (backward compatible)
                 if (parts.size() >= 8) {
-                    try { n->associated_vlan_id = std::stoi(parts[7]); } catch(...) {}
+                    try {
+                        int vlan_id = std::stoi(parts[7]);
+                        if (vlan_id != 0) n->set_associated_vlan_id(vlan_id);
+                    } catch(...) {}
                 }
                 
                 // Load DHCP configuration if present (backward compatible)
                 if (parts.size() >= 12) {
                     try {
-                        n->dhcp_enabled = (std::stoi(parts[8]) == 1);
-                        n->dhcp_upper_half_only = (std::stoi(parts[9]) == 1);
-                        n->dhcp_server_id = std::stoi(parts[10]);
+                        if (std::stoi(parts[8]) == 1) n->set_dhcp_enabled(true);
+                        if (std::stoi(parts[9]) == 1) n->set_dhcp_upper_half_only(true);
+                        int server_id = std::stoi(parts[10]);
+                        if (server_id != -1) n->set_dhcp_server_id(server_id);
                         std::string helper_str = parts[11];
-                        n->dhcp_helper_ip = (helper_str == "NONE") ? "" : helper_str;
+                        if (helper_str != "NONE" && !helper_str.empty()) n->set_dhcp_helper_ip(helper_str);
                     } catch(...) {
                         // Defaults already set in Network struct
                     }
                 }
-                
-                subnets.push_back(n);
+
+                // Older saves have no spare blocks: every subnet in them was taken
+                if (parts.size() >= 14) {
+                    n->set_spare(parts[13] == "1");
+                }
             }
         }
         else if (current_section == "[DEVICE_CONFIGS]") {
@@ -285,7 +305,7 @@ void StateManager::load(std::vector<Device*>& devices, std::vector<Link*>& links
                     Device* d = devices[idx];
                     if (d->get_type() == DeviceType::SWITCH) {
                         Switch* sw = dynamic_cast<Switch*>(d);
-                        std::string ifname = parts[1];
+                        Symbol ifname = parts[1];
                         int vid = std::stoi(parts[2]);
                         bool trunk = (parts[3] == "1");
                         
@@ -333,17 +353,15 @@ void StateManager::load(std::vector<Device*>& devices, std::vector<Link*>& links
         }
     }
     
-    // Reconstruct Network hierarchy (children_ids)
-    for(auto n : subnets) {
-        if (n->parent_id != 0) {
-            // Find parent
-            for(auto p : subnets) {
-                if (p->id == n->parent_id) {
-                    p->children_ids.push_back(n->id);
-                    p->is_split = true; // Implicitly true if children exist
-                    break;
-                }
-            }
+    // Reconstruct Network hierarchy
+    for(auto const& [id, parent_id] : subnet_parents) {
+        if (parent_id == 0) continue;
+        Network* p = subnets.find(parent_id);
+        if (p) {
+            try {
+                subnets.add_child(parent_id, id);
+                p->set_split(true); // Implicitly true if children exist
+            } catch(...) {}
         }
     }
     
@@ -351,13 +369,12 @@ void StateManager::load(std::vector<Device*>& devices, std::vector<Link*>& links
     std::cout << "Loaded full state.\n";
 }
 
-bool StateManager::load_scenario(const std::string& filename, std::vector<Device*>& devices, std::vector<Link*>& links, std::vector<Network*>& subnets) {
+bool StateManager::load_scenario(const std::string& filename, std::vector<Device*>& devices, std::vector<Link*>& links, SubnetStore& subnets) {
     // Phase 1: Clear existing state
     for(auto d : devices) delete d;
     devices.clear();
     for(auto l : links) delete l;
     links.clear();
-    for(auto n : subnets) delete n;
     subnets.clear();
     VlanManager::defined_vlans.clear();
     VlanManager::init(); // Reset to default VLAN 1
@@ -373,10 +390,8 @@ bool StateManager::load_scenario(const std::string& filename, std::vector<Device
     
     std::string line;
     std::string current_section;
+    std::vector<std::pair<int, int>> subnet_parents; // (ID, ParentID), linked once all subnets are read
     
-    // Temporary map for subnet hierarchy reconstruction
-    std::map<int, Network*> subnet_map;
-
     // Phase 2: Parse sections
     while (std::getline(file, line)) {
         trim(line);
@@ -442,48 +457,61 @@ bool StateManager::load_scenario(const std::string& filename, std::vector<Device
                 VlanManager::defined_vlans[id] = name;
             }
         }
-        // [SUBNETS] Section - Store in temp map for hierarchy rebuild
+        // [SUBNETS] Section - Indexed by ID for hierarchy rebuild
         else if (current_section == "[SUBNETS]") {
-            // Format: ID|Network|Slash|ParentID|Name|AssignedTo|AssignedInterface|VlanID|DHCPEnabled|DHCPUpperHalf|DHCPServerID|DHCPHelperIP
+            // Format: ID|Network|Slash|ParentID|Name|AssignedTo|AssignedInterface|VlanID|DHCPEnabled|DHCPUpperHalf|DHCPServerID|DHCPHelperIP|GatewayIP|Spare
             if (parts.size() >= 7) {
-                Network* n = new Network();
-                n->id = std::stoi(parts[0]);
+                int slash = std::stoi(parts[2]);
+                if (slash < 0 || slash > IPV4_NET_BITS) {
+                    std::cerr << "[WARNING] Skipping subnet " << parts[0] << ": invalid prefix /" << slash << "\n";
+                    continue;
+                }
+                if (subnets.find(std::stoi(parts[0]))) {
+                    std::cerr << "[WARNING] Skipping subnet " << parts[0] << ": the id is used twice\n";
+                    continue;
+                }
+                Network* n = subnets.create();
+                subnets.set_id(n, std::stoi(parts[0]));
                 
-                // Parse IP address string to integer
-                int segments[4];
-                sscanf(parts[1].c_str(), "%d.%d.%d.%d", &segments[0], &segments[1], &segments[2], &segments[3]);
-                unsigned int net_int = (segments[0] << 24) | (segments[1] << 16) | (segments[2] << 8) | segments[3];
-                n->set_address(net_int);
+                n->set_address(str_to_address(parts[1]));
                 
-                n->set_slash(std::stoi(parts[2]));
-                unsigned int mask = (n->get_slash() == 0) ? 0 : (~0u) << (32 - n->get_slash());
+                n->set_slash(slash);
+                unsigned int mask = prefix_mask(n->get_slash());
                 n->set_mask(mask);
                 
-                n->parent_id = std::stoi(parts[3]);
-                n->name = parts[4];
-                n->set_assignment(parts[5]);
-                n->set_assigned_interface(parts[6]);
+                subnet_parents.push_back({n->id, std::stoi(parts[3])});
+                // Only fields that differ from the defaults are set, so a bare block
+                // loads without allocating its details
+                if (!parts[4].empty()) n->set_name(parts[4]);
+                if (Symbol(parts[5]) != SYMBOL_FREE) n->set_assignment(parts[5]);
+                if (!parts[6].empty()) n->set_assigned_interface(parts[6]);
                 
                 // Load VLAN ID if present
                 if (parts.size() >= 8) {
-                    try { n->associated_vlan_id = std::stoi(parts[7]); } catch(...) {}
+                    try {
+                        int vlan_id = std::stoi(parts[7]);
+                        if (vlan_id != 0) n->set_associated_vlan_id(vlan_id);
+                    } catch(...) {}
                 }
                 
                 // Load DHCP configuration if present (backward compatible)
                 if (parts.size() >= 12) {
                     try {
-                        n->dhcp_enabled = (std::stoi(parts[8]) == 1);
-                        n->dhcp_upper_half_only = (std::stoi(parts[9]) == 1);
-                        n->dhcp_server_id = std::stoi(parts[10]);
+                        if (std::stoi(parts[8]) == 1) n->set_dhcp_enabled(true);
+                        if (std::stoi(parts[9]) == 1) n->set_dhcp_upper_half_only(true);
+                        int server_id = std::stoi(parts[10]);
+                        if (server_id != -1) n->set_dhcp_server_id(server_id);
                         std::string helper_str = parts[11];
-                        n->dhcp_helper_ip = (helper_str == "NONE") ? "" : helper_str;
+                        if (helper_str != "NONE" && !helper_str.empty()) n->set_dhcp_helper_ip(helper_str);
                     } catch(...) {
                         // Defaults already set in Network struct
                     }
                 }
-                
-                subnet_map[n->id] = n;
-                subnets.push_back(n);
+
+                // Older saves have no spare blocks: every subnet in them was taken
+                if (parts.size() >= 14) {
+                    n->set_spare(parts[13] == "1");
+                }
             }
         }
         // [DEVICE_CONFIGS] Section
@@ -516,9 +544,10 @@ bool StateManager::load_scenario(const std::string& filename, std::vector<Device
                     
                     if (d->get_type() == DeviceType::SWITCH) {
                         Switch* sw = dynamic_cast<Switch*>(d);
-                        // Find interface by name (string match)
+                        // Find interface by name (symbol match)
+                        Symbol ifsymbol = ifname;
                         for(auto& iface : sw->interfaces) {
-                            if(iface.name == ifname) {
+                            if(iface.name == ifsymbol) {
                                 iface.vlan_id = vid;
                                 iface.is_trunk = trunk;
                                 iface.vlan_name = VlanManager::get_vlan_name(vid);
@@ -555,14 +584,14 @@ bool StateManager::load_scenario(const std::string& filename, std::vector<Device
     }
     
     // Phase 3: Reconstruct subnet hierarchy (parent-child relationships)
-    for(auto n : subnets) {
-        if (n->parent_id != 0) {
-            auto it = subnet_map.find(n->parent_id);
-            if (it != subnet_map.end()) {
-                Network* parent = it->second;
-                parent->children_ids.push_back(n->id);
-                parent->is_split = true;
-            }
+    for(auto const& [id, parent_id] : subnet_parents) {
+        if (parent_id == 0) continue;
+        Network* parent = subnets.find(parent_id);
+        if (parent) {
+            try {
+                subnets.add_child(parent_id, id);
+                parent->set_split(true);
+            } catch(...) {}
         }
     }
     
@@ -7,24 +7,26 @@
 
 // Forward declaration
 void print_subtree(Device* dev, std::string prefix, std::set<std::string>& visited, 
-                   const std::vector<Link*>& links, const std::vector<Network*>& subnets);
+                   const std::vector<Link*>& links, const SubnetStore& subnets);
 
 // Helper: Get subnet info string for a given VLAN ID (with DHCP status)
-std::string get_subnet_info_for_vlan(int vlan_id, const std::vector<Network*>& subnets) {
+std::string get_subnet_info_for_vlan(int vlan_id, const SubnetStore& subnets) {
     if (vlan_id <= 1) return "";
     
-    for (auto n : subnets) {
-        if (n->associated_vlan_id == vlan_id && !n->is_split) {
-            std::string net_str = address_to_str(n->get_address());
-            std::string name = n->name.empty() ? VlanManager::get_vlan_name(vlan_id) : n->name;
-            std::string base = "🌐 " + name + " (" + net_str + "/" + std::to_string(n->get_slash()) + ")";
+    for (size_t i = 0; i < subnets.size(); i++) {
+        const NetworkCore& core = subnets.core_at(i);
+        const NetworkDetails& details = subnets.details_at(i);
+        if (details.associated_vlan_id == vlan_id && !(core.flags & NETWORK_SPLIT)) {
+            std::string net_str = address_to_str(core.address);
+            std::string name = details.name.empty() ? VlanManager::get_vlan_name(vlan_id) : details.name.str();
+            std::string base = "🌐 " + name + " (" + net_str + "/" + std::to_string(core.slash) + ")";
             
             // Append DHCP Status Tag
             std::string dhcp_tag = "";
-            if (!n->dhcp_enabled) {
+            if (!details.dhcp_enabled) {
                 dhcp_tag = std::string(Color::CYAN) + " [Static]" + Color::RESET;
-            } else if (!n->dhcp_helper_ip.empty()) {
-                dhcp_tag = std::string(Color::YELLOW) + " [DHCP: Relay -> " + n->dhcp_helper_ip + "]" + Color::RESET;
+            } else if (!details.dhcp_helper_ip.empty()) {
+                dhcp_tag = std::string(Color::YELLOW) + " [DHCP: Relay -> " + details.dhcp_helper_ip + "]" + Color::RESET;
             } else {
                 dhcp_tag = std::string(Color::GREEN) + " [DHCP: Server]" + Color::RESET;
             }
@@ -36,22 +38,24 @@ std::string get_subnet_info_for_vlan(int vlan_id, const std::vector<Network*>& s
 }
 
 // Helper: Get all subnets assigned to a router
-std::vector<std::pair<std::string, std::string>> get_router_subnets(Device* router, const std::vector<Network*>& subnets) {
+std::vector<std::pair<std::string, std::string>> get_router_subnets(Device* router, const SubnetStore& subnets) {
     std::vector<std::pair<std::string, std::string>> results;
     
-    for (auto n : subnets) {
-        if (n->is_split) continue;
+    for (size_t i = 0; i < subnets.size(); i++) {
+        const NetworkCore& core = subnets.core_at(i);
+        if (core.flags & NETWORK_SPLIT) continue;
+        const NetworkDetails& details = subnets.details_at(i);
         
         // Check if this subnet's assigned interface mentions this router
-        std::string assignment = n->get_assignment();
+        std::string assignment = details.assignment_tag.str();
         if (assignment.find(router->get_hostname()) != std::string::npos) {
             // Extract gateway IP (first usable)
-            unsigned int net_addr = n->get_address();
+            unsigned int net_addr = core.address;
             unsigned int gateway = net_addr + 1;
             std::string gw_ip = address_to_str(gateway);
             
-            std::string name = n->name.empty() ? ("Subnet " + std::to_string(n->id)) : n->name;
-            std::string iface = n->get_assigned_interface();
+            std::string name = details.name.empty() ? ("Subnet " + std::to_string(subnets.id_at(i))) : details.name.str();
+            std::string iface = details.assigned_interface.str();
             
             results.push_back({gw_ip, name + " via " + iface});
         }
@@ -61,40 +65,42 @@ std::vector<std::pair<std::string, std::string>> get_router_subnets(Device* rout
 }
 
 // Helper: Get DHCP pools hosted by this router (by router index)
-std::vector<std::pair<std::string, std::string>> get_router_dhcp_pools(Device* router, int router_idx, const std::vector<Network*>& subnets) {
+std::vector<std::pair<std::string, std::string>> get_router_dhcp_pools(Device* router, int router_idx, const SubnetStore& subnets) {
     std::vector<std::pair<std::string, std::string>> pools;
     
-    for (auto n : subnets) {
-        if (n->is_split) continue;
-        if (!n->dhcp_enabled) continue;
+    for (size_t i = 0; i < subnets.size(); i++) {
+        const NetworkCore& core = subnets.core_at(i);
+        if (core.flags & NETWORK_SPLIT) continue;
+        const NetworkDetails& details = subnets.details_at(i);
+        if (!details.dhcp_enabled) continue;
         
         // Check if this router is the designated DHCP server
         bool is_server = false;
         
         // Case 1: dhcp_server_id matches this router's index
-        if (n->dhcp_server_id == router_idx) {
+        if (details.dhcp_server_id == router_idx) {
             is_server = true;
         }
         
         // Case 2: Local DHCP (server_id == -1, no helper) and subnet is assigned to this router
-        if (n->dhcp_server_id == -1 && n->dhcp_helper_ip.empty()) {
-            std::string assignment = n->get_assignment();
+        if (details.dhcp_server_id == -1 && details.dhcp_helper_ip.empty()) {
+            std::string assignment = details.assignment_tag.str();
             if (assignment.find(router->get_hostname()) != std::string::npos) {
                 is_server = true;
             }
         }
         
         if (is_server) {
-            std::string net_str = address_to_str(n->get_address());
-            std::string name = n->name.empty() ? ("Pool " + std::to_string(n->id)) : n->name;
-            pools.push_back({name, net_str + "/" + std::to_string(n->get_slash())});
+            std::string net_str = address_to_str(core.address);
+            std::string name = details.name.empty() ? ("Pool " + std::to_string(subnets.id_at(i))) : details.name.str();
+            pools.push_back({name, net_str + "/" + std::to_string(core.slash)});
         }
     }
     
     return pools;
 }
 
-void Visualizer::draw(const std::vector<Device*>& devices, const std::vector<Link*>& links, const std::vector<Network*>& subnets) {
+void Visualizer::draw(const std::vector<Device*>& devices, const std::vector<Link*>& links, const SubnetStore& subnets) {
     if (devices.empty()) {
         std::cout << "No devices to visualize.\n";
         return;
@@ -150,7 +156,7 @@ void Visualizer::draw(const std::vector<Device*>& devices, const std::vector<Lin
 }
 
 void Visualizer::print_node(Device* dev, std::string prefix, bool is_last, std::set<std::string>& visited, 
-                            const std::vector<Link*>& links, const std::vector<Network*>& subnets) {
+                            const std::vector<Link*>& links, const SubnetStore& subnets) {
     std::string type_str;
     std::string color_code;
     std::string icon;
@@ -183,7 +189,7 @@ void Visualizer::print_node(Device* dev, std::string prefix, bool is_last, std::
 }
 
 void print_subtree(Device* dev, std::string prefix, std::set<std::string>& visited, 
-                   const std::vector<Link*>& links, const std::vector<Network*>& subnets) {
+                   const std::vector<Link*>& links, const SubnetStore& subnets) {
     // Find children
     struct Connection {
         Link* link;
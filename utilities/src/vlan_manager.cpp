@@ -155,14 +155,14 @@ void VlanManager::assign_vlan_to_ports(Switch* sw, const std::vector<std::string
     // 1. Cleanup Phantom Interfaces (e.g. remove 'f0/1' if 'Fa0/1' exists)
     auto& ifaces = sw->interfaces;
     for (auto it = ifaces.begin(); it != ifaces.end(); ) {
-        std::string n = it->name;
+        std::string n = it->name.str();
         if (n.rfind("f0/", 0) == 0) { 
             std::string suffix = n.substr(2);
-            std::string better = "Fa0" + suffix;
+            std::optional<Symbol> better = Symbol::lookup("Fa0" + suffix);
             
             bool found_better = false;
             for(const auto& check : ifaces) {
-                if (check.name == better) { found_better = true; break; }
+                if (better && check.name == *better) { found_better = true; break; }
             }
             
             if (found_better) {
@@ -185,8 +185,8 @@ void VlanManager::assign_vlan_to_ports(Switch* sw, const std::vector<std::string
             
             // Search for existing interface ending with suffix (e.g. "/1")
             for (auto& iface : sw->interfaces) {
-                if (iface.name.length() >= suffix.length()) {
-                    if (iface.name.compare(iface.name.length() - suffix.length(), suffix.length(), suffix) == 0) {
+                if (iface.name.str().length() >= suffix.length()) {
+                    if (iface.name.str().compare(iface.name.str().length() - suffix.length(), suffix.length(), suffix) == 0) {
                         target_iface = &iface;
                         break;
                     }
@@ -203,7 +203,7 @@ void VlanManager::assign_vlan_to_ports(Switch* sw, const std::vector<std::string
             // EXACT NAME MODE: Find interface by name match
             // First try exact match (case-insensitive)
             for (auto& iface : sw->interfaces) {
-                if (iequals(iface.name, pname)) {
+                if (iequals(iface.name.str(), pname)) {
                     target_iface = &iface;
                     break;
                 }
@@ -213,7 +213,7 @@ void VlanManager::assign_vlan_to_ports(Switch* sw, const std::vector<std::string
             // e.g. "Gig0/1" should match "GigabitEthernet0/1"
             if (!target_iface) {
                 for (auto& iface : sw->interfaces) {
-                    if (icontains(iface.name, pname)) {
+                    if (icontains(iface.name.str(), pname)) {
                         target_iface = &iface;
                         break;
                     }
@@ -267,7 +267,7 @@ void VlanManager::delete_vlan(std::vector<Device*>& devices) {
         for (auto& iface : dev->interfaces) {
             if (iface.vlan_id == id) {
                 iface.vlan_id = 1;
-                iface.vlan_name = "default";
+                iface.vlan_name = SYMBOL_DEFAULT;
                 iface.is_trunk = false; // Reset to safe state (access vlan 1)
                 std::cout << Color::YELLOW << "[INFO] Reset Interface " << iface.name << " on " << dev->get_hostname() << " to VLAN 1." << Color::RESET << "\n";
             }
@@ -343,7 +343,7 @@ void VlanManager::menu_manage_vlans(std::vector<Device*>& devices) {
             for(const auto& iface : target_sw->interfaces) {
                 // Filter meaningful ports (e.g. starting with f or g)
                 std::cout << iface.name << ": " 
-                          << (iface.is_trunk ? (Color::MAGENTA + "TRUNK" + Color::RESET) : (Color::CYAN + "VLAN " + std::to_string(iface.vlan_id) + " (" + iface.vlan_name + ")" + Color::RESET)) 
+                          << (iface.is_trunk ? (Color::MAGENTA + "TRUNK" + Color::RESET) : (Color::CYAN + "VLAN " + std::to_string(iface.vlan_id) + " (" + iface.vlan_name.str() + ")" + Color::RESET)) 
                           << "\n";
             }
             
@@ -457,9 +457,9 @@ void VlanManager::inspect_switch_ports(std::vector<Device*>& devices) {
         
         printf("%s%-12s %-10d %-15s [%s]%s\n",
                row_color.c_str(),
-               iface.name.c_str(),
+               iface.name.str().c_str(),
                iface.vlan_id,
-               iface.vlan_name.empty() ? get_vlan_name(iface.vlan_id).c_str() : iface.vlan_name.c_str(),
+               iface.vlan_name.empty() ? get_vlan_name(iface.vlan_id).c_str() : iface.vlan_name.str().c_str(),
                status.c_str(),
                Color::RESET.c_str());
     }
@@ -482,7 +482,7 @@ void VlanManager::inspect_switch_ports(std::vector<Device*>& devices) {
         // Reset all ports
         for (auto& iface : sw->interfaces) {
             iface.vlan_id = 1;
-            iface.vlan_name = "default";
+            iface.vlan_name = SYMBOL_DEFAULT;
             iface.is_trunk = false;
         }
         std::cout << Color::GREEN << Icon::CHECK << " [SUCCESS] All ports on " << sw->get_hostname() << " reset to default." << Color::RESET << "\n";
@@ -491,12 +491,12 @@ void VlanManager::inspect_switch_ports(std::vector<Device*>& devices) {
         Interface* target = nullptr;
         for (auto& iface : sw->interfaces) {
             // Case-insensitive comparison
-            std::string iface_lower = iface.name;
+            std::string iface_lower = iface.name.str();
             std::string input_lower = input;
             std::transform(iface_lower.begin(), iface_lower.end(), iface_lower.begin(), ::tolower);
             std::transform(input_lower.begin(), input_lower.end(), input_lower.begin(), ::tolower);
             
-            if (iface_lower == input_lower || iface.name == input) {
+            if (iface_lower == input_lower || iface.name.str() == input) {
                 target = &iface;
                 break;
             }
@@ -504,7 +504,7 @@ void VlanManager::inspect_switch_ports(std::vector<Device*>& devices) {
         
         if (target) {
             target->vlan_id = 1;
-            target->vlan_name = "default";
+            target->vlan_name = SYMBOL_DEFAULT;
             target->is_trunk = false;
             std::cout << Color::GREEN << Icon::CHECK << " [SUCCESS] " << target->name << " reset to default." << Color::RESET << "\n";
         } else {
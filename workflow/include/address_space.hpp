@@ -0,0 +1,48 @@
+#ifndef ADDRESS_SPACE_HPP
+#define ADDRESS_SPACE_HPP
+
+#include <network.hpp>
+#include <array>
+#include <optional>
+#include <set>
+#include <vector>
+
+// Buddy-system manager for the addresses of a base network.
+// Free blocks are kept in one ordered list per prefix length: allocate() splits the
+// smallest free block that fits, release() merges a block with its free buddy as far
+// up as possible. Every operation walks at most 32 lists, so they are O(log n).
+class AddressSpace
+{
+private:
+    uint32_t network;
+    int base_slash;
+    uint64_t free_addresses;
+    std::array<std::set<uint32_t>, IPV4_NET_BITS + 1> free_blocks;
+
+    static uint64_t block_size(int slash) { return 1ULL << (IPV4_NET_BITS - slash); }
+    bool overlaps_free(Cidr block) const;
+
+public:
+    // The whole base network starts free
+    AddressSpace(uint32_t network, int slash);
+    explicit AddressSpace(Network* base);
+
+    // Lowest free block of the given prefix length, splitting a bigger one if needed
+    std::optional<Cidr> allocate(int slash);
+    // Marks a specific block as used; false if any part of it is not free
+    bool claim(Cidr block);
+    // Returns a used block to the free lists, coalescing it with its buddies. False,
+    // and nothing changes, if the block is misaligned, outside the base network or
+    // any part of it is already free.
+    bool release(Cidr block);
+
+    bool contains(Cidr block) const;
+    uint64_t get_free_addresses() const { return free_addresses; }
+    size_t free_count(int slash) const { return free_blocks[slash].size(); }
+    // Prefix length of the biggest free block, or -1 when the space is full
+    int largest_free_slash() const;
+    // Every free block, ordered by address
+    std::vector<Cidr> free_list() const;
+};
+
+#endif
@@ -2,18 +2,84 @@
 #define CALCULATOR_HPP
 
 #include <network.hpp>
+#include <subnet_range.hpp>
+#include <subnet_table.hpp>
+#include <address_space.hpp>
+#include <result_cache.hpp>
+#include <subnet_store.hpp>
+#include <memory>
+#include <string>
 #include <vector>
 
+// A named host count for the batch VLSM planner
+struct Requirement
+{
+    std::string name;
+    int hosts;
+};
+
+// Figures of a split, without its subnets
+struct SubnetSummary
+{
+    uint64_t total;             // number of new subnets
+    long long hosts_per_net;    // usable hosts in each of them
+    int slash;
+    uint32_t mask;
+    Subnet first;
+    Subnet last;
+};
+
+// Exactly the requested number of subnets plus the space they leave unused
+struct ExactSplit
+{
+    SubnetTable subnets;
+    std::vector<Cidr> free_blocks;
+};
+
 class Calculator
 {
 private:
     Network* base;
-    std::vector<Network*> subnetting(int borrowed_bits);
+    int borrowed_by_networks(int required);
+    int borrowed_by_hosts(int required);
+    SubnetRange subnetting(int borrowed_bits);
+    std::shared_ptr<const SubnetTable> cached(SplitMode mode, int required);
 
 public:
     Calculator(Network* base);
-    std::vector<Network*> subnet_by_networks(int required);
-    std::vector<Network*> subnet_by_hosts(int required);
+    SubnetTable subnet_by_networks(int required);
+    SubnetTable subnet_by_hosts(int required);
+
+    // Same results, memoized in the shared cache: repeating a query returns the same table
+    std::shared_ptr<const SubnetTable> cached_subnet_by_networks(int required);
+    std::shared_ptr<const SubnetTable> cached_subnet_by_hosts(int required);
+    // LRU cache shared by every Calculator
+    static ResultCache& cache();
+
+    // Lazy variants: subnets are computed while iterating, nothing is allocated
+    SubnetRange range_by_networks(int required);
+    SubnetRange range_by_hosts(int required);
+
+    // Exactly `required` subnets instead of the next power of two. By default the
+    // smallest prefix is only used where needed, so the subnets fill the whole base
+    // network with mixed prefixes; with `equal_size` they all get that prefix and the
+    // rest of the base network is returned as aligned free blocks.
+    ExactSplit split_exact(int required, bool equal_size = false);
+
+    // Same checks as subnet_by_*, but only the figures are computed (constant time)
+    SubnetSummary summary_by_networks(int required);
+    SubnetSummary summary_by_hosts(int required);
+    static SubnetSummary summarize(const SubnetRange& range);
+
+    // Host bits of the smallest block holding `hosts` plus network and broadcast.
+    // Throws std::invalid_argument unless `hosts` is at least 1.
+    static int host_bits_for(int hosts);
+
+    // Allocates every requirement from the base network, largest first, and returns the
+    // whole plan tree: the base network is the root (ID 1) and every entry already has
+    // its id and is linked below its parent in the store. Throws if the plan does not fit
+    // or a requirement has fewer than 1 host (see host_bits_for).
+    SubnetStore plan_vlsm(std::vector<Requirement> requirements);
 };
 
-#endif
\ No newline at end of file
+#endif
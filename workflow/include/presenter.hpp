@@ -2,23 +2,46 @@
 #define PRESENTER_HPP
 
 #include <network.hpp>
+#include <subnet_range.hpp>
+#include <subnet_table.hpp>
+#include <calculator.hpp>
 #include <vector>
 #include <iostream>
+#include <optional>
+#include <string_view>
 
-void show_results(std::vector<Network*> results)
+// How result rows are written:
+//  Table   the human readable table
+//  Csv     header line, then id,network,slash,mask,broadcast
+//  Ndjson  one {"id","network","slash","mask","broadcast"} object per line
+//  Binary  16 byte little-endian records: uint32 id, network, broadcast, slash
+enum class OutputFormat
 {
-    std::cout << "--------------------------------------------" << std::endl;
-    std::cout << "ID\tNetwork Address\t\tFull mask address\tBroadcast" << std::endl;
-    Network* net;
-    for(int i = 0; i < results.size(); i++)
-    {
-        net = results[i];
-        std::cout << i << "\t";
-        std::cout << address_to_str(net->get_address()) << "\t/" << net->get_slash() << "\t";
-        std::cout << address_to_str(net->get_mask()) << "\t\t";
-        std::cout << address_to_str(net->get_broadcast()) << std::endl;
-    }
-    std::cout << "--------------------------------------------\n" << std::endl;
-}
+    Table,
+    Csv,
+    Ndjson,
+    Binary
+};
+
+// "table", "csv", "ndjson" or "binary"
+std::optional<OutputFormat> output_format_from_str(std::string_view name);
+
+void show_results(const SubnetTable& results, std::ostream& out = std::cout, OutputFormat format = OutputFormat::Table);
+
+// Streams every subnet of the range, one row at a time, without storing them
+void show_results(const SubnetRange& results, std::ostream& out = std::cout, OutputFormat format = OutputFormat::Table);
+
+// Same rows as show_results, but the index space is cut into chunks that a pool
+// of `threads` workers generates and formats in parallel; chunks are written in order.
+void show_results_parallel(const SubnetRange& results, std::ostream& out, unsigned threads,
+                           OutputFormat format = OutputFormat::Table);
+
+// Prints the figures of a split instead of its subnets; csv and ndjson write them as one
+// record (total, hosts_per_subnet, slash, mask, first_network ... last_broadcast).
+// There is no binary summary record.
+void show_summary(const SubnetSummary& summary, std::ostream& out = std::cout, OutputFormat format = OutputFormat::Table);
+
+// Lists the blocks a split left unused
+void show_free_blocks(const std::vector<Cidr>& blocks, std::ostream& out = std::cout);
 
 #endif
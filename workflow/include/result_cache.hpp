@@ -0,0 +1,76 @@
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include <subnet_table.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Which Calculator query produced a table
+enum class SplitMode : uint8_t
+{
+    Networks,
+    Hosts
+};
+
+// Canonical form of a query: the base network (host bits cleared), the mode and the requirement
+struct QueryKey
+{
+    uint32_t network;
+    int slash;
+    SplitMode mode;
+    int required;
+
+    bool operator==(const QueryKey& other) const
+    {
+        return network == other.network && slash == other.slash && mode == other.mode && required == other.required;
+    }
+};
+
+struct QueryKeyHash
+{
+    size_t operator()(const QueryKey& key) const;
+};
+
+// Bounded LRU cache of calculator results. Tables are shared read only, so a hit
+// costs a lookup and a reference count, and evicting one never invalidates a caller.
+// Both the number of tables and their total rows are bounded: one /8 split into /30s
+// alone is 4M rows, so a count limit by itself would not bound the memory. A table
+// bigger than the whole row budget is not cached at all.
+class ResultCache
+{
+private:
+    typedef std::pair<QueryKey, std::shared_ptr<const SubnetTable>> Entry;
+
+    size_t capacity;
+    size_t row_budget;
+    size_t rows;                // rows of every cached table
+    std::list<Entry> entries;   // most recently used first
+    std::unordered_map<QueryKey, std::list<Entry>::iterator, QueryKeyHash> index;
+    uint64_t hits;
+    uint64_t misses;
+    mutable std::mutex lock;
+
+    void evict();
+
+public:
+    ResultCache(size_t capacity, size_t row_budget);
+
+    // The cached table (and it becomes the most recent one), or nullptr on a miss
+    std::shared_ptr<const SubnetTable> find(const QueryKey& key);
+    void insert(const QueryKey& key, std::shared_ptr<const SubnetTable> table);
+    void clear();
+
+    size_t size() const;
+    size_t get_capacity() const;
+    void set_capacity(size_t capacity);
+    size_t get_rows() const;
+    size_t get_row_budget() const;
+    void set_row_budget(size_t row_budget);
+    uint64_t get_hits() const;
+    uint64_t get_misses() const;
+};
+
+#endif
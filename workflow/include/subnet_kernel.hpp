@@ -0,0 +1,22 @@
+#ifndef SUBNET_KERNEL_HPP
+#define SUBNET_KERNEL_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+// Writes the address and broadcast of subnets [first, first + count) of a split
+// into two output columns. `network` is the base address with its host bits
+// cleared, `block` the number of addresses per subnet and `mask` the new mask.
+typedef void (*SubnetKernel)(uint32_t network, uint32_t block, uint32_t mask, uint64_t first,
+                             size_t count, uint32_t* addresses, uint32_t* broadcasts);
+
+void subnet_kernel_scalar(uint32_t network, uint32_t block, uint32_t mask, uint64_t first,
+                          size_t count, uint32_t* addresses, uint32_t* broadcasts);
+
+// Best kernel for the running CPU (AVX2, SSE2 or scalar), chosen once via cpuid
+SubnetKernel select_subnet_kernel();
+const char* subnet_kernel_name();
+// Kernel by name ("avx2", "sse2" or "scalar"), or nullptr when the CPU can not run it
+SubnetKernel find_subnet_kernel(const char* name);
+
+#endif
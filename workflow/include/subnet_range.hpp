@@ -0,0 +1,99 @@
+#ifndef SUBNET_RANGE_HPP
+#define SUBNET_RANGE_HPP
+
+#include <network.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+
+// One subnet of a split, computed on demand (nothing is allocated)
+struct Subnet
+{
+    uint32_t address;
+    uint32_t broadcast;
+    uint32_t mask;
+    int slash;
+};
+
+// Lazy view over all the subnets obtained by borrowing bits from a base network.
+// Every subnet is derived from its index, so the range uses constant memory
+// no matter how many subnets it describes.
+class SubnetRange
+{
+private:
+    uint32_t network;   // base address with its host bits cleared
+    uint32_t mask;      // mask of the new subnets
+    int slash;          // slash of the new subnets
+    uint64_t block;     // addresses per new subnet
+    uint64_t first;     // index of row 0 in the whole split (non zero for pages)
+    uint64_t count;     // number of new subnets
+
+public:
+    class iterator
+    {
+    private:
+        const SubnetRange* range;
+        uint64_t index;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Subnet;
+        using difference_type = int64_t;
+        using pointer = void;
+        using reference = Subnet;
+
+        iterator() : range(nullptr), index(0) {}
+        iterator(const SubnetRange* range, uint64_t index) : range(range), index(index) {}
+
+        Subnet operator*() const { return (*range)[index]; }
+        Subnet operator[](difference_type n) const { return (*range)[index + n]; }
+        uint64_t get_index() const { return index; }
+
+        iterator& operator++() { ++index; return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++index; return tmp; }
+        iterator& operator--() { --index; return *this; }
+        iterator operator--(int) { iterator tmp = *this; --index; return tmp; }
+        iterator& operator+=(difference_type n) { index += n; return *this; }
+        iterator& operator-=(difference_type n) { index -= n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(range, index + n); }
+        iterator operator-(difference_type n) const { return iterator(range, index - n); }
+        difference_type operator-(const iterator& other) const { return (difference_type)(index - other.index); }
+
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+        bool operator<(const iterator& other) const { return index < other.index; }
+        bool operator>(const iterator& other) const { return index > other.index; }
+        bool operator<=(const iterator& other) const { return index <= other.index; }
+        bool operator>=(const iterator& other) const { return index >= other.index; }
+    };
+
+    SubnetRange(uint32_t base_address, int base_slash, int borrowed_bits);
+
+    uint64_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    int get_slash() const { return slash; }
+    uint32_t get_network() const { return network; }
+    uint32_t get_mask() const { return mask; }
+    uint64_t get_block_size() const { return block; }
+    uint64_t get_first() const { return first; }
+
+    Subnet operator[](uint64_t index) const
+    {
+        uint32_t address = network + (uint32_t)((first + index) * block);
+        return Subnet{address, address | ~mask, mask, slash};
+    }
+
+    // Bounds checked operator[], throws std::out_of_range
+    Subnet at(uint64_t index) const;
+
+    // Index of the subnet holding `address`, or -1 when this range does not cover it
+    int64_t index_of(uint32_t address) const;
+
+    // Rows [offset, offset + limit) of this range as a new range; limit 0 means up to the end
+    SubnetRange page(uint64_t offset, uint64_t limit) const;
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, count); }
+};
+
+#endif
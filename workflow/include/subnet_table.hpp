@@ -0,0 +1,57 @@
+#ifndef SUBNET_TABLE_HPP
+#define SUBNET_TABLE_HPP
+
+#include <network.hpp>
+#include <subnet_range.hpp>
+#include <subnet_store.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Per-subnet metadata, only stored once a row is named or assigned
+struct SubnetMeta
+{
+    std::string name;
+    std::string assignment = "Free";
+};
+
+// Struct-of-arrays container for materialized calculator results.
+// Each row costs 9 bytes (address, broadcast, slash); the columns can be
+// scanned sequentially and metadata lives apart from them.
+class SubnetTable
+{
+private:
+    std::vector<uint32_t> addresses;
+    std::vector<uint32_t> broadcasts;
+    std::vector<uint8_t> slashes;
+    std::unordered_map<size_t, SubnetMeta> metadata;
+
+public:
+    SubnetTable();
+    explicit SubnetTable(const SubnetRange& range);
+
+    size_t size() const { return addresses.size(); }
+    bool empty() const { return addresses.empty(); }
+    void reserve(size_t rows);
+    void push_back(uint32_t address, uint32_t broadcast, int slash);
+
+    uint32_t get_address(size_t row) const { return addresses[row]; }
+    uint32_t get_broadcast(size_t row) const { return broadcasts[row]; }
+    int get_slash(size_t row) const { return slashes[row]; }
+    uint32_t get_mask(size_t row) const { return ~(broadcasts[row] - addresses[row]); }
+
+    const std::vector<uint32_t>& address_column() const { return addresses; }
+    const std::vector<uint32_t>& broadcast_column() const { return broadcasts; }
+    const std::vector<uint8_t>& slash_column() const { return slashes; }
+
+    // Creates the metadata of a row on first use
+    SubnetMeta& attach(size_t row);
+    // Returns nullptr when the row has no metadata
+    const SubnetMeta* find_meta(size_t row) const;
+
+    // Builds a Network for the row in `store`, copying its metadata if any
+    Network* to_network(size_t row, SubnetStore& store) const;
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include <vector>
 #include <iostream>
 #include <memory>
+#include <symbol.hpp>
 
 enum class DeviceType {
     ROUTER,
@@ -22,15 +23,15 @@ enum class CableType {
 class Device; 
 
 struct Interface {
-    std::string name;
+    Symbol name;
     bool is_connected = false;
     Device* neighbor = nullptr;
-    std::string neighbor_port;
+    Symbol neighbor_port;
     
     // VLAN Configuration
     int vlan_id = 1;
     bool is_trunk = false;
-    std::string vlan_name = "default";
+    Symbol vlan_name = SYMBOL_DEFAULT;
     
     // Manual IP Override
     std::string manual_ip = ""; // If set, overrides default/DHCP assigned IP
@@ -169,7 +170,7 @@ struct StaticRoute {
     int router_id;
     std::string dest_net;
     std::string mask;
-    std::string next_hop;
+    std::string next_hop;   // next hop address or exit interface
 };
 
 extern std::vector<StaticRoute> static_routes;
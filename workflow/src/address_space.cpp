@@ -0,0 +1,155 @@
+#include <address_space.hpp>
+#include <prefix.hpp>
+#include <algorithm>
+
+AddressSpace::AddressSpace(uint32_t network, int slash)
+{
+    this->network = network & prefix_mask(slash);
+    this->base_slash = slash;
+    this->free_addresses = block_size(slash);
+    free_blocks[slash].insert(this->network);
+}
+
+AddressSpace::AddressSpace(Network* base)
+    : AddressSpace(base->get_address(), base->get_slash()) {}
+
+std::optional<Cidr> AddressSpace::allocate(int slash)
+{
+    if (slash < base_slash || slash > IPV4_NET_BITS)
+        return std::nullopt;
+
+    // Smallest free block that can hold the request
+    int found = slash;
+    while (found >= base_slash && free_blocks[found].empty())
+        found--;
+    if (found < base_slash)
+        return std::nullopt;
+
+    uint32_t address = *free_blocks[found].begin();
+    free_blocks[found].erase(free_blocks[found].begin());
+
+    // Split it down, keeping the upper halves free
+    while (found < slash)
+    {
+        found++;
+        free_blocks[found].insert(address + (uint32_t)block_size(found));
+    }
+
+    free_addresses -= block_size(slash);
+    return Cidr{address, slash};
+}
+
+bool AddressSpace::claim(Cidr block)
+{
+    if (!contains(block) || (block.address & (uint32_t)(block_size(block.slash) - 1)) != 0)
+        return false;
+
+    // Free block that covers the requested one
+    int found = block.slash;
+    uint32_t address = 0;
+    while (found >= base_slash)
+    {
+        address = block.address & prefix_mask(found);
+        if (free_blocks[found].count(address))
+            break;
+        found--;
+    }
+    if (found < base_slash)
+        return false;
+
+    free_blocks[found].erase(address);
+
+    // Split towards the block, keeping the halves that do not contain it
+    while (found < block.slash)
+    {
+        found++;
+        uint32_t half = (uint32_t)block_size(found);
+        if (block.address & half)
+        {
+            free_blocks[found].insert(address);
+            address += half;
+        }
+        else
+        {
+            free_blocks[found].insert(address + half);
+        }
+    }
+
+    free_addresses -= block_size(block.slash);
+    return true;
+}
+
+bool AddressSpace::overlaps_free(Cidr block) const
+{
+    // A free block at this size or above that covers it
+    for (int slash = block.slash; slash >= base_slash; slash--)
+    {
+        if (free_blocks[slash].count(block.address & prefix_mask(slash)))
+            return true;
+    }
+    // A smaller free block inside it
+    uint64_t end = (uint64_t)block.address + block_size(block.slash);
+    for (int slash = block.slash + 1; slash <= IPV4_NET_BITS; slash++)
+    {
+        auto it = free_blocks[slash].lower_bound(block.address);
+        if (it != free_blocks[slash].end() && *it < end)
+            return true;
+    }
+    return false;
+}
+
+bool AddressSpace::release(Cidr block)
+{
+    if (!contains(block) || (block.address & (uint32_t)(block_size(block.slash) - 1)) != 0)
+        return false;
+    if (overlaps_free(block))
+        return false;
+
+    free_addresses += block_size(block.slash);
+
+    uint32_t address = block.address;
+    int slash = block.slash;
+    while (slash > base_slash)
+    {
+        uint32_t buddy = address ^ (uint32_t)block_size(slash);
+        auto it = free_blocks[slash].find(buddy);
+        if (it == free_blocks[slash].end())
+            break;
+
+        free_blocks[slash].erase(it);
+        address = std::min(address, buddy);
+        slash--;
+    }
+    free_blocks[slash].insert(address);
+    return true;
+}
+
+bool AddressSpace::contains(Cidr block) const
+{
+    if (block.slash < base_slash || block.slash > IPV4_NET_BITS)
+        return false;
+    return (block.address & prefix_mask(base_slash)) == network;
+}
+
+int AddressSpace::largest_free_slash() const
+{
+    for (int slash = base_slash; slash <= IPV4_NET_BITS; slash++)
+    {
+        if (!free_blocks[slash].empty())
+            return slash;
+    }
+    return -1;
+}
+
+std::vector<Cidr> AddressSpace::free_list() const
+{
+    std::vector<Cidr> blocks;
+    for (int slash = base_slash; slash <= IPV4_NET_BITS; slash++)
+    {
+        for (uint32_t address : free_blocks[slash])
+            blocks.push_back(Cidr{address, slash});
+    }
+    std::sort(blocks.begin(), blocks.end(),
+        [](const Cidr& a, const Cidr& b) { return a.address < b.address; });
+    return blocks;
+}
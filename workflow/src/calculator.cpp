@@ -1,27 +1,164 @@
 #include <calculator.hpp>
 #include <logging.hpp>
+#include <subnet_kernel.hpp>
+#include <prefix.hpp>
 #include <math.h>
+#include <algorithm>
+#include <stdexcept>
+
+#define RESULT_CACHE_ENTRIES 64
+#define RESULT_CACHE_ROWS (1 << 22)     // about 36 MB of table columns in total
 
 Calculator::Calculator(Network* base)
 {
     this->base = base;
 }
 
-std::vector<Network*> Calculator::subnet_by_networks(int required)
+SubnetTable Calculator::subnet_by_networks(int required)
+{
+    return SubnetTable(range_by_networks(required));
+}
+
+SubnetTable Calculator::subnet_by_hosts(int required)
+{
+    return SubnetTable(range_by_hosts(required));
+}
+
+std::shared_ptr<const SubnetTable> Calculator::cached_subnet_by_networks(int required)
+{
+    return cached(SplitMode::Networks, required);
+}
+
+std::shared_ptr<const SubnetTable> Calculator::cached_subnet_by_hosts(int required)
+{
+    return cached(SplitMode::Hosts, required);
+}
+
+ResultCache& Calculator::cache()
+{
+    static ResultCache results(RESULT_CACHE_ENTRIES, RESULT_CACHE_ROWS);
+    return results;
+}
+
+std::shared_ptr<const SubnetTable> Calculator::cached(SplitMode mode, int required)
+{
+    QueryKey key{(uint32_t)(base->get_address() & base->get_mask()), base->get_slash(), mode, required};
+    std::shared_ptr<const SubnetTable> table = cache().find(key);
+    if (table)
+    {
+        LOG_DEBUG("Result cache hit ({} hits, {} misses)", cache().get_hits(), cache().get_misses());
+        return table;
+    }
+
+    if (mode == SplitMode::Hosts)
+        table = std::make_shared<const SubnetTable>(subnet_by_hosts(required));
+    else
+        table = std::make_shared<const SubnetTable>(subnet_by_networks(required));
+    cache().insert(key, table);
+    return table;
+}
+
+SubnetRange Calculator::range_by_networks(int required)
+{
+    return subnetting(borrowed_by_networks(required));
+}
+
+SubnetRange Calculator::range_by_hosts(int required)
+{
+    return subnetting(borrowed_by_hosts(required));
+}
+
+ExactSplit Calculator::split_exact(int required, bool equal_size)
+{
+    int borrowed_bits = borrowed_by_networks(required);
+    int slash = base->get_slash() + borrowed_bits;
+    uint32_t network = base->get_address() & base->get_mask();
+    uint64_t block = 1ULL << (IPV4_NET_BITS - slash);
+    uint32_t mask = prefix_mask(slash);
+    uint64_t count = (uint64_t)required;
+    uint64_t end = 1ULL << borrowed_bits;
+
+    ExactSplit split;
+    split.subnets.reserve(count);
+
+    if (equal_size || borrowed_bits == 0)
+    {
+        for (uint64_t i = 0; i < count; i++)
+        {
+            uint32_t address = network + (uint32_t)(i * block);
+            split.subnets.push_back(address, address | ~mask, slash);
+        }
+
+        // Blocks [count, end) are free. The lowest set bit of an index is the largest
+        // aligned run of blocks starting there, and end is a power of two, so every
+        // step takes the biggest free block that fits.
+        for (uint64_t start = count; start < end; start += start & (~start + 1))
+        {
+            int merged_bits = __builtin_ctzll(start);
+            split.free_blocks.push_back(Cidr{network + (uint32_t)(start * block), slash - merged_bits});
+        }
+    }
+    else
+    {
+        // Halve the base network (end / 2 blocks of twice the size) and split in two
+        // only as many halves as needed to reach `required`; the larger ones go first
+        uint64_t whole = end - count;
+        uint32_t whole_mask = mask << 1;
+        for (uint64_t i = 0; i < whole; i++)
+        {
+            uint32_t address = network + (uint32_t)(2 * i * block);
+            split.subnets.push_back(address, address | ~whole_mask, slash - 1);
+        }
+        for (uint64_t i = 2 * whole; i < end; i++)
+        {
+            uint32_t address = network + (uint32_t)(i * block);
+            split.subnets.push_back(address, address | ~mask, slash);
+        }
+    }
+
+    LOG_INFO("Exact split: {} subnets, {} free blocks", split.subnets.size(), split.free_blocks.size());
+    return split;
+}
+
+SubnetSummary Calculator::summary_by_networks(int required)
+{
+    return summarize(range_by_networks(required));
+}
+
+SubnetSummary Calculator::summary_by_hosts(int required)
+{
+    return summarize(range_by_hosts(required));
+}
+
+SubnetSummary Calculator::summarize(const SubnetRange& range)
+{
+    int host_bits = IPV4_NET_BITS - range.get_slash();
+
+    SubnetSummary summary;
+    summary.total = range.size();
+    summary.hosts_per_net = (1LL << host_bits) - 2;
+    summary.slash = range.get_slash();
+    summary.mask = range.get_mask();
+    summary.first = range[0];
+    summary.last = range[range.size() - 1];
+    return summary;
+}
+
+int Calculator::borrowed_by_networks(int required)
 {
     int borrowed_bits = ceil(log2(required));
     int new_slash = this->base->get_slash() + borrowed_bits;
 
     if (new_slash >= IPV4_NET_BITS)
     {
-        logger->error("Can not create {} subnets because {} bits are required, but only {} are available", 
+        LOG_ERROR("Can not create {} subnets because {} bits are required, but only {} are available",
             required, borrowed_bits, IPV4_NET_BITS - base->get_slash());
         exit(1);
     }
-    return subnetting(borrowed_bits);
+    return borrowed_bits;
 }
 
-std::vector<Network*> Calculator::subnet_by_hosts(int required)
+int Calculator::borrowed_by_hosts(int required)
 {
     int host_bits = ceil(log2(required + 2));
     int borrowed_bits = IPV4_NET_BITS - (base->get_slash() + host_bits);
@@ -29,49 +166,127 @@ std::vector<Network*> Calculator::subnet_by_hosts(int required)
     if (borrowed_bits < 0)
     {
         int max_hosts = pow(2, IPV4_NET_BITS - base->get_slash());
-        logger->error("Max hosts per network are {}, but you're asking for [{}]",
+        LOG_ERROR("Max hosts per network are {}, but you're asking for [{}]",
             max_hosts, required);
         exit(1);
     }
-    return subnetting(borrowed_bits);
+    return borrowed_bits;
+}
+
+SubnetRange Calculator::subnetting(int borrowed_bits)
+{
+    SubnetRange range(base->get_address(), base->get_slash(), borrowed_bits);
+    int host_bits = IPV4_NET_BITS - range.get_slash();
+
+    long long hosts_per_net = (1LL << host_bits) - 2;  // minus the network address and the broadcast address
+
+    LOG_DEBUG("Borrowed bits: {}", borrowed_bits);
+    LOG_DEBUG("New slash (network bits): {}", range.get_slash());
+    LOG_DEBUG("Host bits: {}", host_bits);
+    LOG_DEBUG("Subnet kernel: {}", subnet_kernel_name());
+    LOG_INFO("Total of subnets: {}", range.size());
+    LOG_INFO("Hosts per new network: {}", hosts_per_net);
+
+    return range;
 }
 
-std::vector<Network*> Calculator::subnetting(int borrowed_bits)
+int Calculator::host_bits_for(int hosts)
 {
-    int new_mask = (base->get_mask() >> borrowed_bits) | base->get_mask();
-    int new_slash = base->get_slash() + borrowed_bits;
-    int host_bits = IPV4_NET_BITS - new_slash;
+    if (hosts <= 0)
+        throw std::invalid_argument("Host count must be at least 1, got " + std::to_string(hosts));
+
+    int host_bits = 0;
+    while ((1LL << host_bits) < (long long)hosts + 2)
+        host_bits++;
+    return host_bits;
+}
+
+// A requirement placed inside the base network
+struct Allocation
+{
+    uint32_t address;
+    int slash;
+    const Requirement* requirement;
+};
+
+// Adds the node [address/slash] to the plan and recurses into its halves while it
+// contains allocations that are smaller than itself. `first`/`last` delimit the
+// allocations inside the node (they are sorted by address).
+static Network* build_plan_node(uint32_t address, int slash,
+                                const Allocation* first, const Allocation* last,
+                                SubnetStore& plan)
+{
+    Network* node = plan.create(Cidr{address, slash});
+    plan.set_id(node, plan.size());
+
+    if (first == last)
+        return node;  // Free block
 
-    int total_subnets = pow(2, borrowed_bits);
-    int hosts_per_net = pow(2, host_bits) - 2;  // minus the network address and the broadcast address
+    if (last - first == 1 && first->slash == slash)
+    {
+        node->set_name(first->requirement->name);
+        return node;
+    }
 
-    logger->debug("Borrowed bits: {}", borrowed_bits);
-    logger->debug("New slash (network bits): {}", new_slash);
-    logger->debug("Host bits: {}", host_bits);
-    logger->info("Total of subnets: {}", total_subnets);
-    logger->info("Hosts per new network: {}", hosts_per_net);
+    node->set_split(true);
+    node->set_assignment("Split (VLSM Parent)");
 
-    int network_address;
-    int network_broadcast;
+    uint32_t middle = address + (uint32_t)(1ULL << (IPV4_NET_BITS - slash - 1));
+    const Allocation* split = std::lower_bound(first, last, middle,
+        [](const Allocation& a, uint32_t value) { return a.address < value; });
 
-    std::vector<Network*> results;
-    Network* subnet;  // Will be append to the results list
+    Network* low = build_plan_node(address, slash + 1, first, split, plan);
+    Network* high = build_plan_node(middle, slash + 1, split, last, plan);
+    plan.add_child(node->id, low->id);
+    plan.add_child(node->id, high->id);
+    return node;
+}
+
+SubnetStore Calculator::plan_vlsm(std::vector<Requirement> requirements)
+{
+    int base_slash = base->get_slash();
+    uint32_t network = base->get_address() & base->get_mask();
+    uint64_t capacity = 1ULL << (IPV4_NET_BITS - base_slash);
 
-    for(int i = 0; i < total_subnets; i++)
+    // Block size of every requirement: smallest power of two holding hosts + network + broadcast
+    std::vector<Allocation> allocations;
+    allocations.reserve(requirements.size());
+    for (const Requirement& requirement : requirements)
     {
-        subnet = new Network();
+        int host_bits = host_bits_for(requirement.hosts);
 
-        network_address = (i << host_bits) | base->get_address();
-        network_address = new_mask & network_address;
-        network_broadcast = network_address | (~new_mask);
+        if (host_bits > IPV4_NET_BITS - base_slash)
+        {
+            LOG_ERROR("[{}] needs {} hosts, but the base network only has {} addresses",
+                requirement.name, requirement.hosts, capacity);
+            throw std::invalid_argument("Requirement '" + requirement.name + "' does not fit in the base network");
+        }
+        allocations.push_back({0, IPV4_NET_BITS - host_bits, &requirement});
+    }
 
-        subnet->set_address(network_address);
-        subnet->set_broadcast(network_broadcast);
-        subnet->set_mask(new_mask);
-        subnet->set_slash(new_slash);
+    // Largest first, so the buddy allocator packs the blocks without holes
+    std::stable_sort(allocations.begin(), allocations.end(),
+        [](const Allocation& a, const Allocation& b) { return a.slash < b.slash; });
 
-        results.push_back(subnet);
+    AddressSpace space(network, base_slash);
+    for (Allocation& allocation : allocations)
+    {
+        std::optional<Cidr> block = space.allocate(allocation.slash);
+        if (!block)
+        {
+            LOG_ERROR("The requirements need more than the {} addresses of the base network", capacity);
+            throw std::invalid_argument("Requirements do not fit in the base network");
+        }
+        allocation.address = block->address;
     }
+    LOG_INFO("VLSM plan: {} requirements use {} of {} addresses",
+        allocations.size(), capacity - space.get_free_addresses(), capacity);
 
-    return results;
+    // The tree builder walks the blocks in address order
+    std::sort(allocations.begin(), allocations.end(),
+        [](const Allocation& a, const Allocation& b) { return a.address < b.address; });
+
+    SubnetStore plan;
+    build_plan_node(network, base_slash, allocations.data(), allocations.data() + allocations.size(), plan);
+    return plan;
 }
@@ -0,0 +1,356 @@
+#include <presenter.hpp>
+#include <subnet_kernel.hpp>
+#include <prefix.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Only this file uses the standalone fmt, it must not meet spdlog's bundled copy
+#define FMT_HEADER_ONLY
+#include <fmt/format.h>
+
+#define ROWS_PER_CHUNK 16384
+#define CHUNKS_PER_THREAD 4
+#define WRITE_BUFFER_SIZE (1 << 16)
+#define BINARY_RECORD_SIZE 16
+
+#define TABLE_RULE "--------------------------------------------\n"
+#define TABLE_HEADER "ID\tNetwork Address\t\tFull mask address\tBroadcast\n"
+#define CSV_HEADER "id,network,slash,mask,broadcast\n"
+#define CSV_SUMMARY_HEADER "total,hosts_per_subnet,slash,mask,first_network,first_broadcast,last_network,last_broadcast\n"
+
+// Text that goes around the fields of a row:
+// row_start id id_end address slash_column mask mask_end broadcast row_end
+struct RowLayout
+{
+    const char* row_start;
+    const char* id_end;
+    const char* slash_column;   // fmt pattern taking the slash
+    const char* mask_end;
+    const char* row_end;
+};
+
+static const RowLayout TABLE_LAYOUT = {"", "\t", "\t/{}\t", "\t\t", "\n"};
+static const RowLayout CSV_LAYOUT = {"", ",", ",{},", ",", "\n"};
+static const RowLayout NDJSON_LAYOUT = {"{\"id\":", ",\"network\":\"", "\",\"slash\":{},\"mask\":\"", "\",\"broadcast\":\"", "\"}\n"};
+
+static const RowLayout& row_layout(OutputFormat format)
+{
+    if (format == OutputFormat::Csv)
+        return CSV_LAYOUT;
+    if (format == OutputFormat::Ndjson)
+        return NDJSON_LAYOUT;
+    return TABLE_LAYOUT;
+}
+
+static std::string_view header_text(OutputFormat format)
+{
+    if (format == OutputFormat::Table)
+        return TABLE_RULE TABLE_HEADER;
+    if (format == OutputFormat::Csv)
+        return CSV_HEADER;
+    return "";
+}
+
+static std::string_view footer_text(OutputFormat format)
+{
+    return (format == OutputFormat::Table) ? TABLE_RULE "\n" : "";
+}
+
+// Collects result rows in one reusable buffer and hands it to the stream with a
+// single write() whenever it fills up, instead of one stream call (and flush) per field.
+// The slash and mask columns only change with the prefix, so they are formatted once
+// per prefix rather than once per row.
+class ResultWriter
+{
+private:
+    std::ostream& out;
+    OutputFormat format;
+    const RowLayout* layout;
+    fmt::memory_buffer buffer;
+    int slash = -1;
+    std::string slash_text, mask_text;
+
+    void text(std::string_view text)
+    {
+        buffer.append(text.data(), text.data() + text.size());
+    }
+
+    void le32(uint32_t value)
+    {
+        char bytes[4] = {(char)value, (char)(value >> 8), (char)(value >> 16), (char)(value >> 24)};
+        buffer.append(bytes, bytes + 4);
+    }
+
+    void set_prefix(int slash, uint32_t mask)
+    {
+        char digits[IPV4_STR_SIZE];
+        this->slash = slash;
+        slash_text = fmt::format(layout->slash_column, slash);
+        mask_text = std::string(format_address(mask, digits)) + layout->mask_end;
+    }
+
+public:
+    ResultWriter(std::ostream& out, OutputFormat format) : out(out), format(format)
+    {
+        layout = &row_layout(format);
+        buffer.reserve(WRITE_BUFFER_SIZE);
+    }
+
+    ~ResultWriter()
+    {
+        flush();
+    }
+
+    void header()
+    {
+        text(header_text(format));
+    }
+
+    void footer()
+    {
+        text(footer_text(format));
+    }
+
+    void row(uint64_t id, uint32_t address, int slash, uint32_t mask, uint32_t broadcast)
+    {
+        if (format == OutputFormat::Binary)
+        {
+            // id, network, broadcast, slash and three zero bytes, all little-endian
+            le32((uint32_t)id);
+            le32(address);
+            le32(broadcast);
+            le32((uint32_t)slash);
+        }
+        else
+        {
+            if (slash != this->slash)
+                set_prefix(slash, mask);
+
+            char digits[IPV4_STR_SIZE];
+            fmt::format_int number(id);
+            text(layout->row_start);
+            buffer.append(number.data(), number.data() + number.size());
+            text(layout->id_end);
+            text(format_address(address, digits));
+            text(slash_text);
+            text(mask_text);
+            text(format_address(broadcast, digits));
+            text(layout->row_end);
+        }
+        if (buffer.size() >= WRITE_BUFFER_SIZE)
+            flush();
+    }
+
+    void flush()
+    {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+};
+
+std::optional<OutputFormat> output_format_from_str(std::string_view name)
+{
+    if (name == "table")
+        return OutputFormat::Table;
+    if (name == "csv")
+        return OutputFormat::Csv;
+    if (name == "ndjson")
+        return OutputFormat::Ndjson;
+    if (name == "binary")
+        return OutputFormat::Binary;
+    return std::nullopt;
+}
+
+// Formats rows [first, first + count) of the range into `text`, with their IDs in the whole split.
+// `mask` is the mask column with its mask_end already appended.
+static void format_chunk(const SubnetRange& results, const RowLayout& layout, const std::string& mask, uint64_t first, size_t count,
+                         std::vector<uint32_t>& addresses, std::vector<uint32_t>& broadcasts, std::string& text)
+{
+    static const SubnetKernel kernel = select_subnet_kernel();
+    first += results.get_first();
+    kernel(results.get_network(), (uint32_t)results.get_block_size(), results.get_mask(), first, count,
+           addresses.data(), broadcasts.data());
+
+    // Both columns are formatted into fixed slots, then copied row by row
+    thread_local std::vector<char> digits;
+    thread_local std::vector<std::string_view> address_views, broadcast_views;
+    digits.resize(2 * count * IPV4_STR_SIZE);
+    address_views.resize(count);
+    broadcast_views.resize(count);
+    format_address_column(addresses.data(), count, digits.data(), address_views.data());
+    format_address_column(broadcasts.data(), count, digits.data() + count * IPV4_STR_SIZE, broadcast_views.data());
+
+    std::string slash = fmt::format(layout.slash_column, results.get_slash());
+    text.clear();
+    for (size_t i = 0; i < count; i++)
+    {
+        fmt::format_int id(first + i);
+        text += layout.row_start;
+        text.append(id.data(), id.size());
+        text += layout.id_end;
+        text += address_views[i];
+        text += slash;
+        text += mask;
+        text += broadcast_views[i];
+        text += layout.row_end;
+    }
+}
+
+void show_results(const SubnetTable& results, std::ostream& out, OutputFormat format)
+{
+    ResultWriter writer(out, format);
+    writer.header();
+    for(size_t i = 0; i < results.size(); i++)
+        writer.row(i, results.get_address(i), results.get_slash(i), results.get_mask(i), results.get_broadcast(i));
+    writer.footer();
+    writer.flush();
+    out.flush();
+}
+
+void show_results(const SubnetRange& results, std::ostream& out, OutputFormat format)
+{
+    ResultWriter writer(out, format);
+    writer.header();
+    for(auto it = results.begin(); it != results.end(); ++it)
+    {
+        Subnet net = *it;
+        writer.row(results.get_first() + it.get_index(), net.address, net.slash, net.mask, net.broadcast);
+    }
+    writer.footer();
+    writer.flush();
+    out.flush();
+}
+
+void show_results_parallel(const SubnetRange& results, std::ostream& out, unsigned threads, OutputFormat format)
+{
+    uint64_t total_chunks = (results.size() + ROWS_PER_CHUNK - 1) / ROWS_PER_CHUNK;
+    threads = std::max(1u, (unsigned)std::min<uint64_t>(threads, total_chunks));
+    if (threads == 1 || format == OutputFormat::Binary)
+    {
+        // Binary records need no formatting, the sequential writer keeps up with the disk
+        show_results(results, out, format);
+        return;
+    }
+
+    // Ring of formatted chunks: workers fill slot (chunk % ring), the writer drains them in order
+    struct Slot
+    {
+        std::string text;
+        bool ready = false;
+    };
+    size_t ring = threads * CHUNKS_PER_THREAD;
+    std::vector<Slot> slots(ring);
+    std::mutex lock;
+    std::condition_variable changed;
+    uint64_t next_chunk = 0;
+    uint64_t written = 0;
+    const RowLayout& layout = row_layout(format);
+    std::string mask = address_to_str(results.get_mask()) + layout.mask_end;
+
+    auto worker = [&]()
+    {
+        std::vector<uint32_t> addresses(ROWS_PER_CHUNK), broadcasts(ROWS_PER_CHUNK);
+        std::string text;
+        while (true)
+        {
+            uint64_t chunk;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                if (next_chunk == total_chunks)
+                    return;
+                chunk = next_chunk++;
+                // Wait until the writer has freed the slot of this chunk
+                changed.wait(guard, [&]() { return chunk < written + ring; });
+            }
+
+            uint64_t first = chunk * ROWS_PER_CHUNK;
+            size_t count = (size_t)std::min<uint64_t>(ROWS_PER_CHUNK, results.size() - first);
+            format_chunk(results, layout, mask, first, count, addresses, broadcasts, text);
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                Slot& slot = slots[chunk % ring];
+                slot.text.swap(text);
+                slot.ready = true;
+            }
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; i++)
+        pool.emplace_back(worker);
+
+    out << header_text(format);
+    std::string text;
+    for (uint64_t chunk = 0; chunk < total_chunks; chunk++)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            Slot& slot = slots[chunk % ring];
+            changed.wait(guard, [&]() { return slot.ready; });
+            text.swap(slot.text);
+            slot.ready = false;
+            written++;
+        }
+        changed.notify_all();
+        out.write(text.data(), text.size());
+    }
+    out << footer_text(format) << std::flush;
+
+    for (auto& t : pool)
+        t.join();
+}
+
+void show_summary(const SubnetSummary& summary, std::ostream& out, OutputFormat format)
+{
+    if (format == OutputFormat::Csv)
+    {
+        out << CSV_SUMMARY_HEADER;
+        out << fmt::format("{},{},{},{},{},{},{},{}\n", summary.total, summary.hosts_per_net, summary.slash,
+                           address_to_str(summary.mask), address_to_str(summary.first.address),
+                           address_to_str(summary.first.broadcast), address_to_str(summary.last.address),
+                           address_to_str(summary.last.broadcast));
+        out.flush();
+        return;
+    }
+    if (format == OutputFormat::Ndjson)
+    {
+        out << fmt::format("{{\"total\":{},\"hosts_per_subnet\":{},\"slash\":{},\"mask\":\"{}\","
+                           "\"first_network\":\"{}\",\"first_broadcast\":\"{}\","
+                           "\"last_network\":\"{}\",\"last_broadcast\":\"{}\"}}\n",
+                           summary.total, summary.hosts_per_net, summary.slash, address_to_str(summary.mask),
+                           address_to_str(summary.first.address), address_to_str(summary.first.broadcast),
+                           address_to_str(summary.last.address), address_to_str(summary.last.broadcast));
+        out.flush();
+        return;
+    }
+
+    out << "--------------------------------------------\n";
+    out << "Total of subnets:\t" << summary.total << "\n";
+    out << "Hosts per subnet:\t" << summary.hosts_per_net << "\n";
+    out << "New slash:\t\t/" << summary.slash << "\n";
+    out << "Full mask address:\t" << address_to_str(summary.mask) << "\n";
+    out << "First subnet:\t\t" << address_to_str(summary.first.address) << " - " << address_to_str(summary.first.broadcast) << "\n";
+    out << "Last subnet:\t\t" << address_to_str(summary.last.address) << " - " << address_to_str(summary.last.broadcast) << "\n";
+    out << "--------------------------------------------\n" << std::endl;
+}
+
+void show_free_blocks(const std::vector<Cidr>& blocks, std::ostream& out)
+{
+    if (blocks.empty())
+        return;
+
+    out << "Free blocks:\n";
+    for (const Cidr& block : blocks)
+    {
+        uint32_t mask = prefix_mask(block.slash);
+        out << address_to_str(block.address) << "\t/" << block.slash << "\t";
+        out << address_to_str(mask) << "\t\t";
+        out << address_to_str(block.address | ~mask) << "\n";
+    }
+    out << std::endl;
+}
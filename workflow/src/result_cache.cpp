@@ -0,0 +1,119 @@
+#include <result_cache.hpp>
+
+size_t QueryKeyHash::operator()(const QueryKey& key) const
+{
+    uint64_t packed = ((uint64_t)key.network << 32) | ((uint64_t)key.slash << 8) | (uint64_t)key.mode;
+    return std::hash<uint64_t>()(packed) ^ (std::hash<int>()(key.required) * 0x9E3779B97F4A7C15ULL);
+}
+
+ResultCache::ResultCache(size_t capacity, size_t row_budget)
+{
+    this->capacity = capacity;
+    this->row_budget = row_budget;
+    this->rows = 0;
+    this->hits = 0;
+    this->misses = 0;
+}
+
+std::shared_ptr<const SubnetTable> ResultCache::find(const QueryKey& key)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto found = index.find(key);
+    if (found == index.end())
+    {
+        misses++;
+        return nullptr;
+    }
+
+    hits++;
+    entries.splice(entries.begin(), entries, found->second);
+    return found->second->second;
+}
+
+void ResultCache::insert(const QueryKey& key, std::shared_ptr<const SubnetTable> table)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    auto found = index.find(key);
+    if (found != index.end())
+    {
+        auto node = found->second;
+        rows -= node->second->size();
+        index.erase(found);
+        entries.erase(node);
+    }
+    if (table->size() > row_budget)
+        return;
+
+    entries.emplace_front(key, table);
+    index[key] = entries.begin();
+    rows += table->size();
+    evict();
+}
+
+void ResultCache::evict()
+{
+    while (entries.size() > capacity || rows > row_budget)
+    {
+        rows -= entries.back().second->size();
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+void ResultCache::clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    index.clear();
+    rows = 0;
+}
+
+size_t ResultCache::size() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return entries.size();
+}
+
+size_t ResultCache::get_capacity() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return capacity;
+}
+
+void ResultCache::set_capacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    this->capacity = capacity;
+    evict();
+}
+
+size_t ResultCache::get_rows() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return rows;
+}
+
+size_t ResultCache::get_row_budget() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return row_budget;
+}
+
+void ResultCache::set_row_budget(size_t row_budget)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    this->row_budget = row_budget;
+    evict();
+}
+
+uint64_t ResultCache::get_hits() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return hits;
+}
+
+uint64_t ResultCache::get_misses() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return misses;
+}
@@ -0,0 +1,100 @@
+#include <subnet_kernel.hpp>
+#include <cpu_features.hpp>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SUBNET_KERNEL_X86 1
+#endif
+
+void subnet_kernel_scalar(uint32_t network, uint32_t block, uint32_t mask, uint64_t first,
+                          size_t count, uint32_t* addresses, uint32_t* broadcasts)
+{
+    uint32_t address = network + (uint32_t)first * block;
+    for (size_t i = 0; i < count; i++)
+    {
+        addresses[i] = address;
+        broadcasts[i] = address | ~mask;
+        address += block;
+    }
+}
+
+#ifdef SUBNET_KERNEL_X86
+
+// 4 subnets per iteration
+__attribute__((target("sse2")))
+static void subnet_kernel_sse2(uint32_t network, uint32_t block, uint32_t mask, uint64_t first,
+                               size_t count, uint32_t* addresses, uint32_t* broadcasts)
+{
+    uint32_t start = network + (uint32_t)first * block;
+    __m128i current = _mm_setr_epi32(start, start + block, start + 2 * block, start + 3 * block);
+    __m128i step = _mm_set1_epi32(4 * block);
+    __m128i wildcard = _mm_set1_epi32(~mask);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_si128((__m128i*)(addresses + i), current);
+        _mm_storeu_si128((__m128i*)(broadcasts + i), _mm_or_si128(current, wildcard));
+        current = _mm_add_epi32(current, step);
+    }
+    subnet_kernel_scalar(network, block, mask, first + i, count - i, addresses + i, broadcasts + i);
+}
+
+// 8 subnets per iteration
+__attribute__((target("avx2")))
+static void subnet_kernel_avx2(uint32_t network, uint32_t block, uint32_t mask, uint64_t first,
+                               size_t count, uint32_t* addresses, uint32_t* broadcasts)
+{
+    uint32_t start = network + (uint32_t)first * block;
+    __m256i current = _mm256_setr_epi32(start, start + block, start + 2 * block, start + 3 * block,
+                                        start + 4 * block, start + 5 * block, start + 6 * block, start + 7 * block);
+    __m256i step = _mm256_set1_epi32(8 * block);
+    __m256i wildcard = _mm256_set1_epi32(~mask);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm256_storeu_si256((__m256i*)(addresses + i), current);
+        _mm256_storeu_si256((__m256i*)(broadcasts + i), _mm256_or_si256(current, wildcard));
+        current = _mm256_add_epi32(current, step);
+    }
+    subnet_kernel_scalar(network, block, mask, first + i, count - i, addresses + i, broadcasts + i);
+}
+
+#endif
+
+SubnetKernel select_subnet_kernel()
+{
+#ifdef SUBNET_KERNEL_X86
+    if (cpu_has_avx2())
+        return subnet_kernel_avx2;
+    if (cpu_has_sse2())
+        return subnet_kernel_sse2;
+#endif
+    return subnet_kernel_scalar;
+}
+
+const char* subnet_kernel_name()
+{
+#ifdef SUBNET_KERNEL_X86
+    if (cpu_has_avx2())
+        return "avx2";
+    if (cpu_has_sse2())
+        return "sse2";
+#endif
+    return "scalar";
+}
+
+SubnetKernel find_subnet_kernel(const char* name)
+{
+#ifdef SUBNET_KERNEL_X86
+    if (std::strcmp(name, "avx2") == 0)
+        return cpu_has_avx2() ? subnet_kernel_avx2 : nullptr;
+    if (std::strcmp(name, "sse2") == 0)
+        return cpu_has_sse2() ? subnet_kernel_sse2 : nullptr;
+#endif
+    if (std::strcmp(name, "scalar") == 0)
+        return subnet_kernel_scalar;
+    return nullptr;
+}
@@ -0,0 +1,45 @@
+#include <subnet_range.hpp>
+#include <prefix.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+SubnetRange::SubnetRange(uint32_t base_address, int base_slash, int borrowed_bits)
+{
+    uint32_t base_mask = prefix_mask(base_slash);
+
+    this->slash = base_slash + borrowed_bits;
+    this->mask = prefix_mask(slash);
+    this->network = base_address & base_mask;
+    this->block = 1ULL << (IPV4_NET_BITS - slash);
+    this->first = 0;
+    this->count = 1ULL << borrowed_bits;
+}
+
+Subnet SubnetRange::at(uint64_t index) const
+{
+    if (index >= count)
+        throw std::out_of_range("Subnet index " + std::to_string(index) + " is out of range, there are " + std::to_string(count));
+    return (*this)[index];
+}
+
+int64_t SubnetRange::index_of(uint32_t address) const
+{
+    // Every subnet has the same size, so the index is just the offset in blocks.
+    // Addresses outside the base network wrap to an offset past the last subnet.
+    uint64_t index = (uint64_t)(address - network) >> (IPV4_NET_BITS - slash);
+    if (index < first || index >= first + count)
+        return -1;
+    return (int64_t)(index - first);
+}
+
+SubnetRange SubnetRange::page(uint64_t offset, uint64_t limit) const
+{
+    SubnetRange result = *this;
+    offset = std::min(offset, count);
+    result.first = first + offset;
+    result.count = count - offset;
+    if (limit > 0)
+        result.count = std::min(result.count, limit);
+    return result;
+}
@@ -0,0 +1,59 @@
+#include <subnet_table.hpp>
+#include <subnet_kernel.hpp>
+
+SubnetTable::SubnetTable() {}
+
+SubnetTable::SubnetTable(const SubnetRange& range)
+{
+    static const SubnetKernel kernel = select_subnet_kernel();
+
+    size_t rows = range.size();
+    addresses.resize(rows);
+    broadcasts.resize(rows);
+    slashes.assign(rows, (uint8_t)range.get_slash());
+
+    kernel(range.get_network(), (uint32_t)range.get_block_size(), range.get_mask(), range.get_first(), rows,
+           addresses.data(), broadcasts.data());
+}
+
+void SubnetTable::reserve(size_t rows)
+{
+    addresses.reserve(rows);
+    broadcasts.reserve(rows);
+    slashes.reserve(rows);
+}
+
+void SubnetTable::push_back(uint32_t address, uint32_t broadcast, int slash)
+{
+    addresses.push_back(address);
+    broadcasts.push_back(broadcast);
+    slashes.push_back((uint8_t)slash);
+}
+
+SubnetMeta& SubnetTable::attach(size_t row)
+{
+    return metadata[row];
+}
+
+const SubnetMeta* SubnetTable::find_meta(size_t row) const
+{
+    auto it = metadata.find(row);
+    return it == metadata.end() ? nullptr : &it->second;
+}
+
+Network* SubnetTable::to_network(size_t row, SubnetStore& store) const
+{
+    Network* network = store.create();
+    network->set_address(get_address(row));
+    network->set_broadcast(get_broadcast(row));
+    network->set_mask(get_mask(row));
+    network->set_slash(get_slash(row));
+
+    const SubnetMeta* meta = find_meta(row);
+    if (meta)
+    {
+        network->set_name(meta->name);
+        network->set_assignment(meta->assignment);
+    }
+    return network;
+}
@@ -12,8 +12,13 @@ void Device::add_interface(const std::string& name) {
 }
 
 Interface* Device::get_interface(const std::string& name) {
+    // A name that was never interned can not belong to any interface
+    std::optional<Symbol> symbol = Symbol::lookup(name);
+    if (!symbol) {
+        return nullptr;
+    }
     for (auto& iface : interfaces) {
-        if (iface.name == name) {
+        if (iface.name == *symbol) {
             return &iface;
         }
     }
@@ -24,7 +29,7 @@ std::vector<std::string> Device::get_available_ports() const {
     std::vector<std::string> avail;
     for (const auto& iface : interfaces) {
         if (!iface.is_connected) {
-            avail.push_back(iface.name);
+            avail.push_back(iface.name.str());
         }
     }
     return avail;